@@ -0,0 +1,410 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace phosphor::power::util
+{
+
+/**
+ * @class LatencyHistogram
+ *
+ * A histogram of access times in microseconds, with log-linear buckets:
+ * each power of two is split into 4 equal buckets, so a value is off by
+ * at most 25% of itself.  The buckets are a fixed array covering up to
+ * about a minute, and anything longer is counted in the last one.
+ */
+class LatencyHistogram
+{
+  public:
+    /**
+     * The number of buckets per power of two, as a power of two
+     */
+    static constexpr unsigned subBucketBits = 2;
+    static constexpr uint64_t subBuckets = 1 << subBucketBits;
+
+    /**
+     * The largest power of two, in microseconds, with its own buckets
+     */
+    static constexpr unsigned maxExponent = 25;
+
+    static constexpr size_t numBuckets =
+        subBuckets + (maxExponent - subBucketBits + 1) * subBuckets;
+
+    /**
+     * Returns the bucket a value is counted in.
+     *
+     * @param[in] micros - the value in microseconds
+     *
+     * @return size_t - the bucket index
+     */
+    static constexpr size_t bucket(uint64_t micros)
+    {
+        if (micros < subBuckets)
+        {
+            return micros;
+        }
+
+        unsigned exponent = std::bit_width(micros) - 1;
+        if (exponent > maxExponent)
+        {
+            return numBuckets - 1;
+        }
+
+        auto sub = (micros >> (exponent - subBucketBits)) & (subBuckets - 1);
+        return subBuckets + (exponent - subBucketBits) * subBuckets + sub;
+    }
+
+    /**
+     * Returns the smallest value counted in a bucket.
+     *
+     * @param[in] index - the bucket index, up to numBuckets
+     *
+     * @return uint64_t - the value in microseconds
+     */
+    static constexpr uint64_t lowerBound(size_t index)
+    {
+        if (index < subBuckets)
+        {
+            return index;
+        }
+
+        auto exponent = (index - subBuckets) / subBuckets + subBucketBits;
+        auto sub = (index - subBuckets) % subBuckets;
+        return (subBuckets + sub) << (exponent - subBucketBits);
+    }
+
+    /**
+     * Counts a value.
+     *
+     * @param[in] duration - the access time
+     */
+    void record(std::chrono::nanoseconds duration)
+    {
+        auto micros = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration)
+                .count());
+        counts[bucket(micros)]++;
+        total++;
+        sum += micros;
+        max = std::max(max, micros);
+    }
+
+    /**
+     * Returns an upper bound for a percentile of the values.
+     *
+     * @param[in] percent - the percentile, from 0 to 100
+     *
+     * @return uint64_t - the value in microseconds, or 0 if nothing has
+     *                    been counted
+     */
+    uint64_t percentile(double percent) const
+    {
+        auto wanted = static_cast<uint64_t>(percent / 100.0 * total + 0.5);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            seen += counts[i];
+            if ((seen >= wanted) && (seen > 0))
+            {
+                // The top of the bucket, which can't be past the maximum
+                return std::min(lowerBound(i + 1) - 1, max);
+            }
+        }
+        return max;
+    }
+
+    /**
+     * Writes the values as one line of text.
+     *
+     * @param[in] out - the stream to write to
+     */
+    void print(std::ostream& out) const
+    {
+        out << "count=" << total
+            << " mean=" << (total == 0 ? 0 : sum / total)
+            << "us p50=" << percentile(50) << "us p90=" << percentile(90)
+            << "us p99=" << percentile(99) << "us max=" << max << "us";
+    }
+
+    /**
+     * Writes the bucket counts, leaving out the empty ones.
+     *
+     * @param[in] out - the stream to write to
+     */
+    void printBuckets(std::ostream& out) const
+    {
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            if (counts[i] != 0)
+            {
+                out << " [" << lowerBound(i) << "," << lowerBound(i + 1)
+                    << ")us:" << counts[i];
+            }
+        }
+    }
+
+    /**
+     * Returns the number of values counted.
+     */
+    uint64_t count() const
+    {
+        return total;
+    }
+
+  private:
+    std::array<uint64_t, numBuckets> counts{};
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+};
+
+/**
+ * The statistics kept for one attribute of a device
+ */
+struct AccessStats
+{
+    LatencyHistogram latency;
+    uint64_t errors = 0;
+    uint64_t retries = 0;
+};
+
+/**
+ * @class AccessStatsRegistry
+ *
+ * Keeps access statistics for each attribute of each device the process
+ * talks to, such as a sysfs file of a PMBus device or a command code of an
+ * I2C device.
+ *
+ * Nothing is recorded until enable() is called, so programs that don't
+ * report the statistics don't pay for them.
+ */
+class AccessStatsRegistry
+{
+  public:
+    /**
+     * Gets the process-wide registry.
+     *
+     * @return AccessStatsRegistry& - the registry
+     */
+    static AccessStatsRegistry& get()
+    {
+        static AccessStatsRegistry registry;
+        return registry;
+    }
+
+    /**
+     * Starts recording statistics.
+     */
+    void enable()
+    {
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns whether statistics are being recorded.
+     */
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records one access.
+     *
+     * @param[in] device - the device name
+     * @param[in] attribute - the attribute name
+     * @param[in] duration - how long the access took
+     * @param[in] failed - true if the access failed
+     * @param[in] retries - the number of times the access was retried
+     */
+    void record(std::string_view device, std::string_view attribute,
+                std::chrono::nanoseconds duration, bool failed,
+                unsigned retries)
+    {
+        std::lock_guard lock{mutex};
+
+        auto deviceStats = stats.find(device);
+        if (deviceStats == stats.end())
+        {
+            deviceStats = stats.emplace(device, Attributes{}).first;
+        }
+
+        auto attributeStats = deviceStats->second.find(attribute);
+        if (attributeStats == deviceStats->second.end())
+        {
+            attributeStats =
+                deviceStats->second.emplace(attribute, AccessStats{}).first;
+        }
+
+        auto& entry = attributeStats->second;
+        entry.latency.record(duration);
+        entry.errors += failed ? 1 : 0;
+        entry.retries += retries;
+    }
+
+    /**
+     * Returns a copy of the statistics for an attribute.
+     *
+     * @param[in] device - the device name
+     * @param[in] attribute - the attribute name
+     *
+     * @return AccessStats - the statistics, empty if nothing was recorded
+     */
+    AccessStats find(std::string_view device, std::string_view attribute)
+    {
+        std::lock_guard lock{mutex};
+
+        auto deviceStats = stats.find(device);
+        if (deviceStats != stats.end())
+        {
+            auto attributeStats = deviceStats->second.find(attribute);
+            if (attributeStats != deviceStats->second.end())
+            {
+                return attributeStats->second;
+            }
+        }
+        return {};
+    }
+
+    /**
+     * Writes the statistics as text, one device and attribute per line
+     * followed by a line with its histogram buckets.
+     *
+     * @param[in] out - the stream to write to
+     */
+    void dump(std::ostream& out)
+    {
+        std::lock_guard lock{mutex};
+
+        for (const auto& [device, attributes] : stats)
+        {
+            for (const auto& [attribute, entry] : attributes)
+            {
+                out << device << " " << attribute << " ";
+                entry.latency.print(out);
+                out << " errors=" << entry.errors
+                    << " retries=" << entry.retries << "\n ";
+                entry.latency.printBuckets(out);
+                out << "\n";
+            }
+        }
+    }
+
+    /**
+     * Writes the statistics to a file, replacing it.
+     *
+     * @param[in] path - the file to write
+     */
+    void dump(const std::filesystem::path& path)
+    {
+        std::ofstream file{path, std::ios::trunc};
+        dump(file);
+    }
+
+    /**
+     * Drops all statistics.
+     */
+    void clear()
+    {
+        std::lock_guard lock{mutex};
+        stats.clear();
+    }
+
+  private:
+    AccessStatsRegistry() = default;
+
+    using Attributes = std::map<std::string, AccessStats, std::less<>>;
+
+    std::atomic<bool> enabled{false};
+    std::mutex mutex;
+    std::map<std::string, Attributes, std::less<>> stats;
+};
+
+/**
+ * @class AccessTimer
+ *
+ * Times an access from construction to destruction and records it in the
+ * AccessStatsRegistry, when it is enabled.  The access is counted as failed
+ * if setFailed() was called or an exception is leaving the scope.
+ *
+ * The names must stay valid for the lifetime of the timer.
+ */
+class AccessTimer
+{
+  public:
+    AccessTimer(const AccessTimer&) = delete;
+    AccessTimer& operator=(const AccessTimer&) = delete;
+
+    /**
+     * Constructor
+     *
+     * @param[in] device - the device name
+     * @param[in] attribute - the attribute name
+     */
+    AccessTimer(std::string_view device, std::string_view attribute) :
+        device(device), attribute(attribute),
+        enabled(AccessStatsRegistry::get().isEnabled()),
+        exceptions(std::uncaught_exceptions())
+    {
+        if (enabled)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~AccessTimer()
+    {
+        if (enabled)
+        {
+            // Don't let recording change the errno of the access
+            auto rc = errno;
+            AccessStatsRegistry::get().record(
+                device, attribute, std::chrono::steady_clock::now() - start,
+                failed || (std::uncaught_exceptions() > exceptions), retries);
+            errno = rc;
+        }
+    }
+
+    /**
+     * Marks the access as failed.
+     */
+    void setFailed()
+    {
+        failed = true;
+    }
+
+    /**
+     * Sets the number of times the access was retried.
+     *
+     * @param[in] count - the retry count
+     */
+    void setRetries(unsigned count)
+    {
+        retries = count;
+    }
+
+  private:
+    std::string_view device;
+    std::string_view attribute;
+    bool enabled;
+    int exceptions;
+    bool failed = false;
+    unsigned retries = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace phosphor::power::util
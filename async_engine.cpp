@@ -0,0 +1,155 @@
+/**
+ * Copyright © 2017 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "async_engine.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+namespace phosphor::power::util
+{
+
+AsyncEngine::AsyncEngine(const sdeventplus::Event& event, size_t threads) :
+    eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (!eventFd)
+    {
+        throw std::system_error{errno, std::generic_category(),
+                                "Failed to create eventfd"};
+    }
+
+    eventSource.emplace(event, eventFd(), EPOLLIN,
+                        [this](sdeventplus::source::IO&, int, uint32_t) {
+                            jobsFinished();
+                        });
+
+    threads = std::max(threads, size_t{1});
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back(&AsyncEngine::runWorker, this);
+    }
+}
+
+AsyncEngine::~AsyncEngine()
+{
+    {
+        std::lock_guard lock{mutex};
+        stopping = true;
+    }
+    workReady.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void AsyncEngine::submit(const std::string& key, Work work, Done done)
+{
+    {
+        std::lock_guard lock{mutex};
+        queued.push_back({key, std::move(work), std::move(done), nullptr});
+        jobCount++;
+    }
+    workReady.notify_one();
+}
+
+size_t AsyncEngine::pending() const
+{
+    std::lock_guard lock{mutex};
+    return jobCount;
+}
+
+void AsyncEngine::runWorker()
+{
+    std::unique_lock lock{mutex};
+
+    while (true)
+    {
+        // The oldest job whose key isn't already running.  Jobs behind it
+        // with the same key stay queued, which keeps them in order.
+        auto next = queued.end();
+        workReady.wait(lock, [this, &next] {
+            next = std::find_if(queued.begin(), queued.end(),
+                                [this](const auto& job) {
+                                    return !runningKeys.contains(job.key);
+                                });
+            return stopping || (next != queued.end());
+        });
+
+        if (stopping)
+        {
+            return;
+        }
+
+        auto job = std::move(*next);
+        queued.erase(next);
+        runningKeys.insert(job.key);
+
+        lock.unlock();
+        try
+        {
+            job.work();
+        }
+        catch (...)
+        {
+            job.error = std::current_exception();
+        }
+        lock.lock();
+
+        runningKeys.erase(job.key);
+        finished.push_back(std::move(job));
+
+        uint64_t count = 1;
+        [[maybe_unused]] auto rc = write(eventFd(), &count, sizeof(count));
+
+        // A job with the same key may be runnable now
+        workReady.notify_all();
+    }
+}
+
+void AsyncEngine::jobsFinished()
+{
+    uint64_t count = 0;
+    [[maybe_unused]] auto rc = read(eventFd(), &count, sizeof(count));
+
+    std::vector<Job> jobs;
+    {
+        std::lock_guard lock{mutex};
+        jobs.swap(finished);
+    }
+
+    for (auto& job : jobs)
+    {
+        {
+            std::lock_guard lock{mutex};
+            jobCount--;
+        }
+
+        if (job.done)
+        {
+            job.done(job.error);
+        }
+    }
+}
+
+} // namespace phosphor::power::util
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "file_descriptor.hpp"
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace phosphor::power::util
+{
+
+/**
+ * @class AsyncEngine
+ *
+ * Runs blocking work, like reading a sysfs file or doing an I2C transaction,
+ * on a pool of worker threads, and then calls a completion function back on
+ * the sdeventplus event loop.  A device that hangs then only holds up its
+ * own work instead of D-Bus handling and every other device.
+ *
+ * Work is submitted with a key, such as a device path.  Work with the same
+ * key runs in the order it was submitted and never at the same time, so the
+ * work functions for a device don't need to be thread safe with each other.
+ * Work with different keys may run at the same time.
+ *
+ * The completion functions run on the thread running the event loop, so
+ * they can use D-Bus and the rest of the application as usual.
+ */
+class AsyncEngine
+{
+  public:
+    AsyncEngine() = delete;
+    AsyncEngine(const AsyncEngine&) = delete;
+    AsyncEngine& operator=(const AsyncEngine&) = delete;
+    AsyncEngine(AsyncEngine&&) = delete;
+    AsyncEngine& operator=(AsyncEngine&&) = delete;
+
+    /**
+     * The work to run on a worker thread
+     */
+    using Work = std::function<void()>;
+
+    /**
+     * The function called on the event loop when the work is done, with the
+     * exception the work threw, if any
+     */
+    using Done = std::function<void(std::exception_ptr)>;
+
+    /**
+     * The number of worker threads used when not specified
+     */
+    static constexpr size_t defaultThreads = 4;
+
+    /**
+     * Constructor
+     *
+     * @param[in] event - the event loop to call the completion functions on
+     * @param[in] threads - the number of worker threads
+     */
+    explicit AsyncEngine(const sdeventplus::Event& event,
+                         size_t threads = defaultThreads);
+
+    /**
+     * Destructor
+     *
+     * Work that hasn't started yet is dropped without calling its
+     * completion function.  Work that is running is waited for.
+     */
+    ~AsyncEngine();
+
+    /**
+     * Queues work to run on a worker thread.
+     *
+     * @param[in] key - work with the same key runs one at a time, in order
+     * @param[in] work - the work
+     * @param[in] done - called on the event loop after the work is done
+     */
+    void submit(const std::string& key, Work work, Done done);
+
+    /**
+     * Returns the number of submitted jobs whose completion function hasn't
+     * been called yet.
+     *
+     * @return size_t - the job count
+     */
+    size_t pending() const;
+
+  private:
+    struct Job
+    {
+        std::string key;
+        Work work;
+        Done done;
+        std::exception_ptr error;
+    };
+
+    /**
+     * The worker thread function.  Runs jobs until the engine is destroyed.
+     */
+    void runWorker();
+
+    /**
+     * Called on the event loop when there are finished jobs, to call their
+     * completion functions.
+     */
+    void jobsFinished();
+
+    /**
+     * The eventfd the workers signal finished jobs on
+     */
+    FileDescriptor eventFd;
+
+    /**
+     * The event source for eventFd
+     */
+    std::optional<sdeventplus::source::IO> eventSource;
+
+    /**
+     * Protects everything below
+     */
+    mutable std::mutex mutex;
+
+    /**
+     * Signaled when there is work, or on shutdown
+     */
+    std::condition_variable workReady;
+
+    /**
+     * Jobs waiting for a worker
+     */
+    std::deque<Job> queued;
+
+    /**
+     * The keys of the jobs running on a worker
+     */
+    std::set<std::string> runningKeys;
+
+    /**
+     * Jobs whose completion function needs to be called
+     */
+    std::vector<Job> finished;
+
+    /**
+     * The number of jobs submitted and not completed
+     */
+    size_t jobCount = 0;
+
+    /**
+     * Set when the engine is being destroyed
+     */
+    bool stopping = false;
+
+    /**
+     * The worker threads
+     */
+    std::vector<std::thread> workers;
+};
+
+} // namespace phosphor::power::util
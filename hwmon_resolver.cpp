@@ -0,0 +1,202 @@
+/**
+ * Copyright © 2017 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hwmon_resolver.hpp"
+
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace phosphor::pmbus
+{
+
+namespace
+{
+
+// A uevent is the header, then a few KEY=VALUE strings, so this is plenty.
+constexpr size_t maxEventSize = 8192;
+
+// The kernel's uevent multicast group
+constexpr uint32_t kernelEvents = 1;
+
+constexpr std::string_view hwmonDir{"/hwmon/hwmon"};
+
+} // namespace
+
+HwmonResolver& HwmonResolver::get()
+{
+    static HwmonResolver resolver;
+    return resolver;
+}
+
+HwmonResolver::HwmonResolver()
+{
+    phosphor::power::util::FileDescriptor fd{
+        socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+               NETLINK_KOBJECT_UEVENT)};
+    if (!fd)
+    {
+        return;
+    }
+
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = kernelEvents;
+    if (bind(fd(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) ==
+        0)
+    {
+        uevents = std::move(fd);
+    }
+}
+
+fs::path HwmonResolver::find(const fs::path& basePath)
+{
+    std::lock_guard lock{mutex};
+
+    if (!uevents)
+    {
+        return scan(basePath);
+    }
+
+    processEvents();
+
+    auto entry = cache.find(basePath);
+    if (entry != cache.end())
+    {
+        return entry->second;
+    }
+
+    auto dir = scan(basePath);
+
+    // Don't cache a missing directory, the driver may still be probing.
+    if (!dir.empty())
+    {
+        cache.emplace(basePath, dir);
+    }
+    return dir;
+}
+
+void HwmonResolver::clear()
+{
+    std::lock_guard lock{mutex};
+    cache.clear();
+}
+
+void HwmonResolver::processEvents()
+{
+    std::array<char, maxEventSize> buffer;
+
+    while (true)
+    {
+        auto size = recv(uevents(), buffer.data(), buffer.size(), 0);
+        if (size < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                // Events were dropped, so nothing cached can be trusted.
+                cache.clear();
+                continue;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        // The header is ACTION@DEVPATH.  Events from udev start with
+        // "libudev" instead, but only the kernel group is joined.
+        std::string_view header{buffer.data(),
+                                strnlen(buffer.data(),
+                                        static_cast<size_t>(size))};
+        auto at = header.find('@');
+        if (at != std::string_view::npos)
+        {
+            processEvent(header.substr(0, at), header.substr(at + 1));
+        }
+    }
+}
+
+void HwmonResolver::processEvent(std::string_view action,
+                                 std::string_view devPath)
+{
+    std::string_view device;
+
+    auto hwmon = devPath.rfind(hwmonDir);
+    if (hwmon != std::string_view::npos)
+    {
+        if ((action != "add") && (action != "remove"))
+        {
+            return;
+        }
+
+        // /devices/.../3-0068/hwmon/hwmon3
+        device = devPath.substr(0, hwmon);
+    }
+    else if ((action == "bind") || (action == "unbind") ||
+             (action == "remove"))
+    {
+        // /devices/.../3-0068
+        device = devPath;
+    }
+    else
+    {
+        return;
+    }
+
+    device = device.substr(device.rfind('/') + 1);
+    if (device.empty())
+    {
+        return;
+    }
+
+    // The cache is keyed by paths like /sys/bus/i2c/devices/3-0068, which
+    // are links to the /sys/devices paths in the events, so compare names.
+    std::erase_if(cache, [device](const auto& entry) {
+        return entry.first.filename() == device;
+    });
+}
+
+fs::path HwmonResolver::scan(const fs::path& basePath)
+{
+    fs::path path{basePath};
+    path /= "hwmon";
+
+    // Make sure the directory exists, otherwise for things that can be
+    // dynamically present or not present an exception will be thrown if the
+    // hwmon directory is not there, resulting in a program termination.
+    std::error_code ec;
+    if (fs::is_directory(path, ec))
+    {
+        // look for <basePath>/hwmon/hwmonN/
+        for (auto& f : fs::directory_iterator(path, ec))
+        {
+            if ((f.path().filename().string().find("hwmon") !=
+                 std::string::npos) &&
+                (fs::is_directory(f.path(), ec)))
+            {
+                return f.path().filename();
+            }
+        }
+    }
+
+    return {};
+}
+
+} // namespace phosphor::pmbus
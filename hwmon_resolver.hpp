@@ -0,0 +1,109 @@
+#pragma once
+
+#include "file_descriptor.hpp"
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace phosphor::pmbus
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class HwmonResolver
+ *
+ * Finds the hwmon directory of a device, like hwmon3 in
+ * /sys/bus/i2c/devices/3-0068/hwmon/hwmon3.
+ *
+ * The directories found are cached for the whole process, so that every
+ * PMBus object for a device doesn't have to walk sysfs again.
+ *
+ * A device's entry is dropped when the kernel sends a uevent for one of its
+ * hwmon devices being added or removed, or for its driver being bound or
+ * unbound.  sysfs doesn't generate inotify events for the directories the
+ * kernel creates, so inotify can't be used for this.  If the uevent socket
+ * can't be opened nothing is cached.
+ */
+class HwmonResolver
+{
+  public:
+    HwmonResolver(const HwmonResolver&) = delete;
+    HwmonResolver& operator=(const HwmonResolver&) = delete;
+    HwmonResolver(HwmonResolver&&) = delete;
+    HwmonResolver& operator=(HwmonResolver&&) = delete;
+    ~HwmonResolver() = default;
+
+    /**
+     * Gets the process-wide resolver.
+     *
+     * @return HwmonResolver& - the resolver
+     */
+    static HwmonResolver& get();
+
+    /**
+     * Finds the hwmon directory of a device.
+     *
+     * @param[in] basePath - the sysfs directory of the device
+     *
+     * @return path - the hwmon directory name, like hwmon3, or an empty
+     *                path if the device doesn't have one
+     */
+    fs::path find(const fs::path& basePath);
+
+    /**
+     * Drops all cached directories.
+     */
+    void clear();
+
+  private:
+    HwmonResolver();
+
+    /**
+     * Reads the pending uevents and drops the cached directories of the
+     * devices they are for.
+     *
+     * Must be called with the mutex held.
+     */
+    void processEvents();
+
+    /**
+     * Drops the cached directory of the device a uevent is for, if it is
+     * a hwmon add or remove, or a driver bind or unbind.
+     *
+     * Must be called with the mutex held.
+     *
+     * @param[in] action - the uevent action, like add
+     * @param[in] devPath - the uevent device path, relative to /sys
+     */
+    void processEvent(std::string_view action, std::string_view devPath);
+
+    /**
+     * Walks <basePath>/hwmon looking for the hwmon directory.
+     *
+     * @param[in] basePath - the sysfs directory of the device
+     *
+     * @return path - the hwmon directory name, or an empty path
+     */
+    static fs::path scan(const fs::path& basePath);
+
+    /**
+     * The netlink socket the kernel uevents are received on
+     */
+    phosphor::power::util::FileDescriptor uevents;
+
+    /**
+     * The hwmon directory names, by device sysfs directory
+     */
+    std::map<fs::path, fs::path> cache;
+
+    /**
+     * Protects the cache and the socket
+     */
+    std::mutex mutex;
+};
+
+} // namespace phosphor::pmbus
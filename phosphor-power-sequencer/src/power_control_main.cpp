@@ -15,6 +15,7 @@
  */
 
 #include "power_control.hpp"
+#include "service_cache.hpp"
 
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/event.hpp>
@@ -25,6 +26,9 @@ int main()
     auto event = sdeventplus::Event::get_default();
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
 
+    // Look up each D-Bus service once instead of on every access
+    phosphor::power::util::ServiceCache::get().enable(bus);
+
     phosphor::power::sequencer::PowerControl control{bus, event};
     return event.loop();
 }
@@ -479,19 +479,24 @@ void UCD90320Monitor::onFailureCheckRails(
     if (statusWord & status_word::VOUT_FAULT)
     {
         constexpr size_t numberPages = 32;
+        static_assert(numberPages <= MAX_PAGES);
         for (size_t page = 0; page < numberPages; page++)
         {
-            auto statusVout = pmbusInterface.insertPageNum(STATUS_VOUT, page);
-            if (pmbusInterface.exists(statusVout, Type::Debug))
+            if (pmbusInterface.exists(PagedAttribute::statusVout, page,
+                                      Type::Debug))
             {
-                uint8_t vout = pmbusInterface.read(statusVout, Type::Debug);
+                uint8_t vout = pmbusInterface.read(PagedAttribute::statusVout,
+                                                   page, Type::Debug);
 
                 if (vout)
                 {
                     // If any bits are on log them, though some are just
                     // warnings so they won't cause errors
                     log<level::INFO>(
-                        fmt::format("{}, value: {:#04x}", statusVout, vout)
+                        fmt::format("{}, value: {:#04x}",
+                                    getPagedName(PagedAttribute::statusVout,
+                                                 page),
+                                    vout)
                             .c_str());
 
                     // Log errors if any non-warning bits on
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <optional>
+
+namespace phosphor::power::manager
+{
+
+/**
+ * @class LastSent
+ *
+ * Remembers the last value sent to another service, so the same value isn't
+ * sent again on every poll.
+ *
+ * The value is forgotten when sending it fails, so it is sent again, and
+ * when the receiver may have lost it, such as after a power cycle or when
+ * the receiver restarts, so the next value is sent even if it is the same.
+ */
+template <typename T>
+class LastSent
+{
+  public:
+    /**
+     * @brief Returns whether a value needs to be sent.
+     *
+     * @param[in] value - The value
+     *
+     * @return true unless the value is the last one sent
+     */
+    bool needsSend(const T& value) const
+    {
+        return last != value;
+    }
+
+    /**
+     * @brief Records that a value was sent.
+     *
+     * @param[in] value - The value
+     */
+    void sent(const T& value)
+    {
+        last = value;
+    }
+
+    /**
+     * @brief Forgets a value that couldn't be sent.
+     *
+     * Does nothing if another value was sent since.
+     *
+     * @param[in] value - The value
+     */
+    void failed(const T& value)
+    {
+        if (last == value)
+        {
+            last.reset();
+        }
+    }
+
+    /**
+     * @brief Forgets the last value, so the next one is sent.
+     */
+    void reset()
+    {
+        last.reset();
+    }
+
+  private:
+    /** @brief The last value sent, if it is still known to be received */
+    std::optional<T> last;
+};
+
+} // namespace phosphor::power::manager
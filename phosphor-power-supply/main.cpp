@@ -13,17 +13,24 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "access_stats.hpp"
 #include "psu_manager.hpp"
+#include "service_cache.hpp"
 
 #include <CLI/CLI.hpp>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/source/signal.hpp>
+#include <stdplus/signal.hpp>
 
 #include <filesystem>
 
 using namespace phosphor::power;
 
+// The file the device access statistics are written to on a USR1 signal
+constexpr auto accessStatsFile = "/tmp/phosphor-psu-monitor-access-stats";
+
 int main(void)
 {
     try
@@ -39,8 +46,23 @@ int main(void)
         // handle both sd_events (for the timers) and dbus signals.
         bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
 
+        // Look up each D-Bus service once instead of on every access
+        util::ServiceCache::get().enable(bus);
+
+        // Block USR1 before the manager starts its read threads, so they
+        // inherit the mask and the signal is only handled by the event loop
+        stdplus::signal::block(SIGUSR1);
+
         manager::PSUManager manager(bus, event);
 
+        // Write the device access statistics on USR1 signals
+        util::AccessStatsRegistry::get().enable();
+        sdeventplus::source::Signal signal(
+            event, SIGUSR1, [](auto&, const auto*) {
+                util::AccessStatsRegistry::get().dump(
+                    std::filesystem::path{accessStatsFile});
+            });
+
         return manager.run();
     }
     catch (const std::exception& e)
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace phosphor::power::manager
+{
+
+/**
+ * @class PollInterval
+ *
+ * Chooses how long to wait between polls of the power supplies.
+ *
+ * After something changes, such as a power supply being plugged in, the
+ * power being turned on, or a new STATUS_WORD bit turning on, the power
+ * supplies are polled fast for a few cycles so the follow-on faults are
+ * seen right away.  After that they are polled at the normal interval, and
+ * once every power supply has reported a clean status for a while, at a
+ * longer idle interval.
+ */
+class PollInterval
+{
+  public:
+    /** @brief Interval used right after a change */
+    static constexpr std::chrono::milliseconds fast{100};
+
+    /** @brief Interval used while settling, or while a fault is reported */
+    static constexpr std::chrono::milliseconds normal{1000};
+
+    /** @brief Interval used once all power supplies have stayed clean */
+    static constexpr std::chrono::milliseconds idle{2000};
+
+    /** @brief Number of polls done at the fast interval after a change */
+    static constexpr size_t fastCycles = 10;
+
+    /** @brief Number of clean polls in a row needed to go idle */
+    static constexpr size_t idleCycles = 30;
+
+    /**
+     * @brief Returns the current interval.
+     */
+    std::chrono::milliseconds get() const
+    {
+        return interval;
+    }
+
+    /**
+     * @brief Switches to the fast interval after a change.
+     */
+    void wake()
+    {
+        fastLeft = fastCycles;
+        cleanCycles = 0;
+        interval = fast;
+    }
+
+    /**
+     * @brief Chooses the interval after a poll.
+     *
+     * @param[in] clean - true if every power supply present reported a
+     *                    clean status
+     *
+     * @return The interval to wait before the next poll
+     */
+    std::chrono::milliseconds update(bool clean)
+    {
+        if (!clean)
+        {
+            cleanCycles = 0;
+        }
+        else if (cleanCycles < idleCycles)
+        {
+            cleanCycles++;
+        }
+
+        if (fastLeft > 0)
+        {
+            fastLeft--;
+        }
+
+        if (fastLeft > 0)
+        {
+            interval = fast;
+        }
+        else if (cleanCycles >= idleCycles)
+        {
+            interval = idle;
+        }
+        else
+        {
+            interval = normal;
+        }
+
+        return interval;
+    }
+
+  private:
+    /** @brief The current interval */
+    std::chrono::milliseconds interval = normal;
+
+    /** @brief Number of polls left at the fast interval */
+    size_t fastLeft = 0;
+
+    /** @brief Number of clean polls in a row, up to idleCycles */
+    size_t cleanCycles = 0;
+};
+
+} // namespace phosphor::power::manager
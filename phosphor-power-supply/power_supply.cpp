@@ -9,6 +9,8 @@
 
 #include <xyz/openbmc_project/Common/Device/error.hpp>
 
+#include <array>
+#include <charconv>
 #include <chrono> // sleep_for()
 #include <cmath>
 #include <cstdint> // uint8_t...
@@ -27,9 +29,32 @@ constexpr auto bindDelay = 1000;
 // records.
 constexpr auto INPUT_HISTORY_MAX_RECORDS = 120;
 
+// The hwmon alarm files that openAlarms() opens.
+constexpr std::array<const char*, 6> alarmFiles{
+    "in1_lcrit_alarm",  "in1_crit_alarm", "curr1_crit_alarm",
+    "temp1_crit_alarm", "fan1_alarm",     "fan1_fault"};
+
 using namespace phosphor::logging;
 using namespace sdbusplus::xyz::openbmc_project::Common::Device::Error;
 
+// Converts the leading number in a sysfs value to a double without the
+// allocations std::stod() needs.  Throws like std::stod() on failure.
+static double toDouble(std::string_view value)
+{
+    double result = 0;
+    auto [ptr, ec] =
+        std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec == std::errc::result_out_of_range)
+    {
+        throw std::out_of_range("Value out of range: " + std::string{value});
+    }
+    if ((ec != std::errc{}) || (ptr == value.data()))
+    {
+        throw std::invalid_argument("Invalid number: " + std::string{value});
+    }
+    return result;
+}
+
 PowerSupply::PowerSupply(sdbusplus::bus::bus& bus, const std::string& invpath,
                          std::uint8_t i2cbus, std::uint16_t i2caddr,
                          const std::string& driver,
@@ -182,33 +207,41 @@ void PowerSupply::updatePresenceGPIO()
                                       shortName, presentOld, present)
                               .c_str());
 
-        auto invpath = inventoryPath.substr(strlen(INVENTORY_OBJ_PATH));
+        // Setting up the device uses the PMBus interface, which a status
+        // reader may be using on a worker thread.
+        whenReadDone([this, nowPresent = present] {
+            std::lock_guard lock{pmbusMutex};
 
-        bindOrUnbindDriver(present);
-        if (present)
-        {
-            // If the power supply was present, then missing, and present again,
-            // the hwmon path may have changed. We will need the correct/updated
-            // path before any reads or writes are attempted.
-            pmbusIntf->findHwmonDir();
-        }
+            auto invpath = inventoryPath.substr(strlen(INVENTORY_OBJ_PATH));
 
-        setPresence(bus, invpath, present, shortName);
-        setupInputHistory();
-        updateInventory();
+            bindOrUnbindDriver(nowPresent);
+            if (nowPresent)
+            {
+                // If the power supply was present, then missing, and present
+                // again, the hwmon path may have changed. We will need the
+                // correct/updated path before any reads or writes are
+                // attempted.  If the driver hasn't created it yet, it is
+                // looked for again on the next access.
+                pmbusIntf->findHwmonDir();
+            }
 
-        // Need Functional to already be correct before calling this.
-        checkAvailability();
+            setPresence(bus, invpath, nowPresent, shortName);
+            setupInputHistory();
+            updateInventory();
 
-        if (present)
-        {
-            onOffConfig(phosphor::pmbus::ON_OFF_CONFIG_CONTROL_PIN_ONLY);
-            clearFaults();
-            // Indicate that the input history data and timestamps between all
-            // the power supplies that are present in the system need to be
-            // synchronized.
-            syncHistoryRequired = true;
-        }
+            // Need Functional to already be correct before calling this.
+            checkAvailability();
+
+            if (nowPresent)
+            {
+                onOffConfig(phosphor::pmbus::ON_OFF_CONFIG_CONTROL_PIN_ONLY);
+                clearFaults();
+                // Indicate that the input history data and timestamps
+                // between all the power supplies that are present in the
+                // system need to be synchronized.
+                syncHistoryRequired = true;
+            }
+        });
     }
 }
 
@@ -522,150 +555,261 @@ void PowerSupply::analyzeVinUVFault()
 
 void PowerSupply::analyze()
 {
-    using namespace phosphor::pmbus;
+    checkPresence();
 
+    if (present)
+    {
+        analyzeStatus(getStatusReader()());
+    }
+}
+
+void PowerSupply::checkPresence()
+{
     if (presenceGPIO)
     {
         updatePresenceGPIO();
     }
+}
 
-    if (present)
+std::function<PowerSupply::StatusReadings()> PowerSupply::getStatusReader()
+{
+    bool traceErrors = (readFail < LOG_LIMIT);
+    bool readHistory = inputHistorySupported && recordManager && present;
+    return [this, traceErrors, readHistory] {
+        return readStatus(traceErrors, readHistory);
+    };
+}
+
+PowerSupply::StatusReadings PowerSupply::readStatus(bool traceErrors,
+                                                    bool readHistory) const
+{
+    using namespace phosphor::pmbus;
+
+    std::lock_guard lock{pmbusMutex};
+    StatusReadings readings;
+
+    try
     {
-        try
+        readings.statusWord =
+            pmbusIntf->read(STATUS_WORD, Type::Debug, traceErrors);
+
+        if (*readings.statusWord)
         {
-            statusWordOld = statusWord;
-            statusWord = pmbusIntf->read(STATUS_WORD, Type::Debug,
-                                         (readFail < LOG_LIMIT));
-            // Read worked, reset the fail count.
-            readFail = 0;
+            // Read the registers that roll up into STATUS_WORD back to
+            // back.  These are separate reads, so a bit can still change
+            // between them.
+            static const std::array<Attribute, 7> statusAttributes{
+                {{STATUS_INPUT, Type::Debug},
+                 {STATUS_MFR, Type::Debug},
+                 {STATUS_CML, Type::Debug},
+                 {std::string{getPagedName(PagedAttribute::statusVout, 0)},
+                  Type::Debug},
+                 {STATUS_IOUT, Type::Debug},
+                 {STATUS_FANS_1_2, Type::Debug},
+                 {STATUS_TEMPERATURE, Type::Debug}}};
+            readings.statusRegisters = pmbusIntf->readMany(statusAttributes);
+        }
 
-            if (statusWord)
-            {
-                statusInput = pmbusIntf->read(STATUS_INPUT, Type::Debug);
-                statusMFR = pmbusIntf->read(STATUS_MFR, Type::Debug);
-                statusCML = pmbusIntf->read(STATUS_CML, Type::Debug);
-                auto status0Vout = pmbusIntf->insertPageNum(STATUS_VOUT, 0);
-                statusVout = pmbusIntf->read(status0Vout, Type::Debug);
-                statusIout = pmbusIntf->read(STATUS_IOUT, Type::Debug);
-                statusFans12 = pmbusIntf->read(STATUS_FANS_1_2, Type::Debug);
-                statusTemperature =
-                    pmbusIntf->read(STATUS_TEMPERATURE, Type::Debug);
+        // Note: readInputVoltage() has its own try/catch.
+        readInputVoltage(readings.actualInputVoltage, readings.inputVoltage);
 
-                analyzeCMLFault();
+        if (readHistory)
+        {
+            // Read just the most recent average/max record
+            readings.history = pmbusIntf->readBinary(
+                INPUT_HISTORY, Type::HwmonDeviceDebug,
+                history::RecordManager::RAW_RECORD_SIZE);
+        }
+    }
+    catch (const ReadFailure& e)
+    {
+        readings.readFailed = true;
+    }
 
-                analyzeInputFault();
+    return readings;
+}
 
-                analyzeVoutOVFault();
+void PowerSupply::analyzeStatus(const StatusReadings& readings)
+{
+    using namespace phosphor::pmbus;
 
-                analyzeIoutOCFault();
+    if (readings.statusWord)
+    {
+        statusWordOld = statusWord;
+        statusWord = *readings.statusWord;
+        // Read worked, reset the fail count.
+        readFail = 0;
 
-                analyzeVoutUVFault();
+        if (statusWord && readings.statusRegisters)
+        {
+            const auto& values = *readings.statusRegisters;
+            statusInput = values[0];
+            statusMFR = values[1];
+            statusCML = values[2];
+            statusVout = values[3];
+            statusIout = values[4];
+            statusFans12 = values[5];
+            statusTemperature = values[6];
 
-                analyzeFanFault();
+            analyzeCMLFault();
 
-                analyzeTemperatureFault();
+            analyzeInputFault();
 
-                analyzePgoodFault();
+            analyzeVoutOVFault();
 
-                analyzeMFRFault();
+            analyzeIoutOCFault();
 
-                analyzeVinUVFault();
-            }
-            else
-            {
-                if (statusWord != statusWordOld)
-                {
-                    log<level::INFO>(fmt::format("{} STATUS_WORD = {:#06x}",
-                                                 shortName, statusWord)
-                                         .c_str());
-                }
+            analyzeVoutUVFault();
 
-                // if INPUT/VIN_UV fault was on, it cleared, trace it.
-                if (inputFault)
-                {
-                    log<level::INFO>(
-                        fmt::format(
-                            "{} INPUT fault cleared: STATUS_WORD = {:#06x}",
-                            shortName, statusWord)
-                            .c_str());
-                }
+            analyzeFanFault();
 
-                if (vinUVFault)
-                {
-                    log<level::INFO>(
-                        fmt::format("{} VIN_UV cleared: STATUS_WORD = {:#06x}",
-                                    shortName, statusWord)
-                            .c_str());
-                }
+            analyzeTemperatureFault();
 
-                if (pgoodFault > 0)
-                {
-                    log<level::INFO>(
-                        fmt::format("{} pgoodFault cleared", shortName)
-                            .c_str());
-                }
+            analyzePgoodFault();
 
-                clearFaultFlags();
+            analyzeMFRFault();
+
+            analyzeVinUVFault();
+        }
+        else if (!statusWord)
+        {
+            if (statusWord != statusWordOld)
+            {
+                log<level::INFO>(fmt::format("{} STATUS_WORD = {:#06x}",
+                                             shortName, statusWord)
+                                     .c_str());
             }
 
-            // Save off old inputVoltage value.
-            // Get latest inputVoltage.
-            // If voltage went from below minimum, and now is not, clear faults.
-            // Note: getInputVoltage() has its own try/catch.
-            int inputVoltageOld = inputVoltage;
-            double actualInputVoltageOld = actualInputVoltage;
-            getInputVoltage(actualInputVoltage, inputVoltage);
-            if ((inputVoltageOld == in_input::VIN_VOLTAGE_0) &&
-                (inputVoltage != in_input::VIN_VOLTAGE_0))
+            // if INPUT/VIN_UV fault was on, it cleared, trace it.
+            if (inputFault)
             {
                 log<level::INFO>(
-                    fmt::format(
-                        "{} READ_VIN back in range: actualInputVoltageOld = {} "
-                        "actualInputVoltage = {}",
-                        shortName, actualInputVoltageOld, actualInputVoltage)
+                    fmt::format("{} INPUT fault cleared: STATUS_WORD = {:#06x}",
+                                shortName, statusWord)
                         .c_str());
-                clearVinUVFault();
             }
-            else if (vinUVFault && (inputVoltage != in_input::VIN_VOLTAGE_0))
+
+            if (vinUVFault)
             {
                 log<level::INFO>(
-                    fmt::format(
-                        "{} CLEAR_FAULTS: vinUVFault {} actualInputVoltage {}",
-                        shortName, vinUVFault, actualInputVoltage)
+                    fmt::format("{} VIN_UV cleared: STATUS_WORD = {:#06x}",
+                                shortName, statusWord)
                         .c_str());
-                // Do we have a VIN_UV fault latched that can now be cleared
-                // due to voltage back in range? Attempt to clear the fault(s),
-                // re-check faults on next call.
-                clearVinUVFault();
             }
-            else if (std::abs(actualInputVoltageOld - actualInputVoltage) >
-                     10.0)
+
+            if (pgoodFault > 0)
             {
                 log<level::INFO>(
-                    fmt::format(
-                        "{} actualInputVoltageOld = {} actualInputVoltage = {}",
-                        shortName, actualInputVoltageOld, actualInputVoltage)
-                        .c_str());
+                    fmt::format("{} pgoodFault cleared", shortName).c_str());
             }
 
-            checkAvailability();
+            clearFaultFlags();
+        }
+    }
 
-            if (inputHistorySupported)
-            {
-                updateHistory();
-            }
+    // The values after a failed read weren't read
+    bool statusRead = readings.statusWord &&
+                      (!statusWord || readings.statusRegisters);
+    if (statusRead)
+    {
+        // Save off old inputVoltage value.
+        // Use latest inputVoltage.
+        // If voltage went from below minimum, and now is not, clear faults.
+        int inputVoltageOld = inputVoltage;
+        double actualInputVoltageOld = actualInputVoltage;
+        actualInputVoltage = readings.actualInputVoltage;
+        inputVoltage = readings.inputVoltage;
+        if ((inputVoltageOld == in_input::VIN_VOLTAGE_0) &&
+            (inputVoltage != in_input::VIN_VOLTAGE_0))
+        {
+            log<level::INFO>(
+                fmt::format(
+                    "{} READ_VIN back in range: actualInputVoltageOld = {} "
+                    "actualInputVoltage = {}",
+                    shortName, actualInputVoltageOld, actualInputVoltage)
+                    .c_str());
+            clearVinUVFault();
         }
-        catch (const ReadFailure& e)
+        else if (vinUVFault && (inputVoltage != in_input::VIN_VOLTAGE_0))
         {
-            if (readFail < SIZE_MAX)
-            {
-                readFail++;
-            }
-            if (readFail == LOG_LIMIT)
-            {
-                phosphor::logging::commit<ReadFailure>();
-            }
+            log<level::INFO>(
+                fmt::format(
+                    "{} CLEAR_FAULTS: vinUVFault {} actualInputVoltage {}",
+                    shortName, vinUVFault, actualInputVoltage)
+                    .c_str());
+            // Do we have a VIN_UV fault latched that can now be cleared
+            // due to voltage back in range? Attempt to clear the fault(s),
+            // re-check faults on next call.
+            clearVinUVFault();
+        }
+        else if (std::abs(actualInputVoltageOld - actualInputVoltage) > 10.0)
+        {
+            log<level::INFO>(
+                fmt::format(
+                    "{} actualInputVoltageOld = {} actualInputVoltage = {}",
+                    shortName, actualInputVoltageOld, actualInputVoltage)
+                    .c_str());
+        }
+
+        checkAvailability();
+
+        if (inputHistorySupported && readings.history)
+        {
+            updateHistory(*readings.history);
+        }
+    }
+
+    if (readings.readFailed)
+    {
+        if (readFail < SIZE_MAX)
+        {
+            readFail++;
+        }
+        if (readFail == LOG_LIMIT)
+        {
+            phosphor::logging::commit<ReadFailure>();
+        }
+    }
+}
+
+void PowerSupply::readDone()
+{
+    readInProgress = false;
+
+    auto work = std::move(readDoneWork);
+    readDoneWork.clear();
+    for (auto& function : work)
+    {
+        try
+        {
+            function();
         }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("{} presence update error: {}", shortName,
+                            e.what())
+                    .c_str());
+        }
+    }
+}
+
+void PowerSupply::readTimedOut()
+{
+    StatusReadings readings;
+    readings.readFailed = true;
+    analyzeStatus(readings);
+}
+
+void PowerSupply::whenReadDone(std::function<void()> work)
+{
+    if (readInProgress)
+    {
+        readDoneWork.push_back(std::move(work));
+    }
+    else
+    {
+        work();
     }
 }
 
@@ -673,6 +817,8 @@ void PowerSupply::onOffConfig(uint8_t data)
 {
     using namespace phosphor::pmbus;
 
+    std::lock_guard lock{pmbusMutex};
+
     if (present)
     {
         log<level::INFO>("ON_OFF_CONFIG write", entry("DATA=0x%02X", data));
@@ -695,6 +841,8 @@ void PowerSupply::onOffConfig(uint8_t data)
 
 void PowerSupply::clearVinUVFault()
 {
+    std::lock_guard lock{pmbusMutex};
+
     // Read in1_lcrit_alarm to clear bits 3 and 4 of STATUS_INPUT.
     // The fault bits in STAUTS_INPUT roll-up to STATUS_WORD. Clearing those
     // bits in STATUS_INPUT should result in the corresponding STATUS_WORD bits
@@ -706,8 +854,32 @@ void PowerSupply::clearVinUVFault()
     vinUVFault = 0;
 }
 
+std::vector<phosphor::power::util::FileDescriptor> PowerSupply::openAlarms()
+{
+    std::lock_guard lock{pmbusMutex};
+
+    std::vector<phosphor::power::util::FileDescriptor> alarms;
+
+    if (present)
+    {
+        for (const auto& name : alarmFiles)
+        {
+            auto fd =
+                pmbusIntf->openPollable(name, phosphor::pmbus::Type::Hwmon);
+            if (fd)
+            {
+                alarms.push_back(std::move(fd));
+            }
+        }
+    }
+
+    return alarms;
+}
+
 void PowerSupply::clearFaults()
 {
+    std::lock_guard lock{pmbusMutex};
+
     log<level::DEBUG>(
         fmt::format("clearFaults() inventoryPath: {}", inventoryPath).c_str());
     faultLogged = false;
@@ -749,26 +921,30 @@ void PowerSupply::inventoryChanged(sdbusplus::message::message& msg)
     auto valPropMap = msgData.find(PRESENT_PROP);
     if (valPropMap != msgData.end())
     {
-        if (std::get<bool>(valPropMap->second))
-        {
-            present = true;
-            // TODO: Immediately trying to read or write the "files" causes
-            // read or write failures.
-            using namespace std::chrono_literals;
-            std::this_thread::sleep_for(20ms);
-            pmbusIntf->findHwmonDir();
-            onOffConfig(phosphor::pmbus::ON_OFF_CONFIG_CONTROL_PIN_ONLY);
-            clearFaults();
-            updateInventory();
-        }
-        else
-        {
-            present = false;
+        present = std::get<bool>(valPropMap->second);
 
-            // Clear out the now outdated inventory properties
-            updateInventory();
-        }
-        checkAvailability();
+        // Setting up the device uses the PMBus interface, which a status
+        // reader may be using on a worker thread.
+        whenReadDone([this, nowPresent = present] {
+            std::lock_guard lock{pmbusMutex};
+
+            if (nowPresent)
+            {
+                // The device driver may not have created the hwmon files
+                // yet, in which case they are looked for again on the next
+                // access.
+                pmbusIntf->findHwmonDir();
+                onOffConfig(phosphor::pmbus::ON_OFF_CONFIG_CONTROL_PIN_ONLY);
+                clearFaults();
+                updateInventory();
+            }
+            else
+            {
+                // Clear out the now outdated inventory properties
+                updateInventory();
+            }
+            checkAvailability();
+        });
     }
 }
 
@@ -796,8 +972,10 @@ void PowerSupply::inventoryAdded(sdbusplus::message::message& msg)
                                              inventoryPath, present)
                                      .c_str());
 
-                updateInventory();
-                checkAvailability();
+                whenReadDone([this] {
+                    updateInventory();
+                    checkAvailability();
+                });
             }
         }
     }
@@ -807,23 +985,23 @@ void PowerSupply::updateInventory()
 {
     using namespace phosphor::pmbus;
 
+    std::lock_guard lock{pmbusMutex};
+
 #if IBM_VPD
     std::string ccin;
     std::string pn;
     std::string fn;
     std::string header;
     std::string sn;
-    using PropertyMap =
-        std::map<std::string,
-                 std::variant<std::string, std::vector<uint8_t>, bool>>;
+    using PropertyMap = InventoryInterfaces::mapped_type;
     PropertyMap assetProps;
     PropertyMap operProps;
     PropertyMap versionProps;
     PropertyMap ipzvpdDINFProps;
     PropertyMap ipzvpdVINIProps;
-    using InterfaceMap = std::map<std::string, PropertyMap>;
-    InterfaceMap interfaces;
-    using ObjectMap = std::map<sdbusplus::message::object_path, InterfaceMap>;
+    InventoryInterfaces interfaces;
+    using ObjectMap =
+        std::map<sdbusplus::message::object_path, InventoryInterfaces>;
     ObjectMap object;
 #endif
     log<level::DEBUG>(
@@ -941,8 +1119,30 @@ void PowerSupply::updateInventory()
         operProps.emplace(FUNCTIONAL_PROP, present);
         interfaces.emplace(OPERATIONAL_STATE_IFACE, std::move(operProps));
 
+        // Only send the interfaces that changed since the last update, as
+        // the inventory manager emits PropertiesChanged for every interface
+        // it is sent.
+        for (auto it = interfaces.begin(); it != interfaces.end();)
+        {
+            auto published = publishedInventory.find(it->first);
+            if ((published != publishedInventory.end()) &&
+                (published->second == it->second))
+            {
+                it = interfaces.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (interfaces.empty())
+        {
+            return;
+        }
+
         auto path = inventoryPath.substr(strlen(INVENTORY_OBJ_PATH));
-        object.emplace(path, std::move(interfaces));
+        object.emplace(path, interfaces);
 
         try
         {
@@ -962,6 +1162,12 @@ void PowerSupply::updateInventory()
             method.append(std::move(object));
 
             auto reply = bus.call(method);
+
+            for (auto& [interface, properties] : interfaces)
+            {
+                publishedInventory.insert_or_assign(interface,
+                                                    std::move(properties));
+            }
         }
         catch (const std::exception& e)
         {
@@ -971,6 +1177,11 @@ void PowerSupply::updateInventory()
         }
 #endif
     }
+    else
+    {
+        // A power supply plugged in later may have different VPD
+        publishedInventory.clear();
+    }
 }
 
 auto PowerSupply::getMaxPowerOut() const
@@ -985,11 +1196,11 @@ auto PowerSupply::getMaxPowerOut() const
         {
             // Read max_power_out, should be direct format
             auto maxPowerOutStr =
-                pmbusIntf->readString(MFR_POUT_MAX, Type::HwmonDeviceDebug);
+                pmbusIntf->readStringView(MFR_POUT_MAX, Type::HwmonDeviceDebug);
             log<level::INFO>(fmt::format("{} MFR_POUT_MAX read {}", shortName,
                                          maxPowerOutStr)
                                  .c_str());
-            maxPowerOut = std::stod(maxPowerOutStr);
+            maxPowerOut = toDouble(maxPowerOutStr);
         }
         catch (const std::exception& e)
         {
@@ -1073,7 +1284,7 @@ void PowerSupply::setupInputHistory()
     }
 }
 
-void PowerSupply::updateHistory()
+void PowerSupply::updateHistory(const std::vector<uint8_t>& data)
 {
     if (!recordManager)
     {
@@ -1081,17 +1292,6 @@ void PowerSupply::updateHistory()
         return;
     }
 
-    if (!present)
-    {
-        // Cannot read when not present
-        return;
-    }
-
-    // Read just the most recent average/max record
-    auto data =
-        pmbusIntf->readBinary(INPUT_HISTORY, pmbus::Type::HwmonDeviceDebug,
-                              history::RecordManager::RAW_RECORD_SIZE);
-
     // Update D-Bus only if something changed (a new record ID, or cleared
     // out)
     auto changed = recordManager->add(data);
@@ -1110,37 +1310,56 @@ void PowerSupply::getInputVoltage(double& actualInputVoltage,
     actualInputVoltage = in_input::VIN_VOLTAGE_0;
     inputVoltage = in_input::VIN_VOLTAGE_0;
 
-    if (present)
+    if (present && readInProgress)
     {
-        try
-        {
-            // Read input voltage in millivolts
-            auto inputVoltageStr = pmbusIntf->readString(READ_VIN, Type::Hwmon);
+        // Use the values the status reader read last, rather than wait for
+        // it to let go of the PMBus interface
+        actualInputVoltage = this->actualInputVoltage;
+        inputVoltage = this->inputVoltage;
+    }
+    else if (present)
+    {
+        readInputVoltage(actualInputVoltage, inputVoltage);
+    }
+}
 
-            // Convert to volts
-            actualInputVoltage = std::stod(inputVoltageStr) / 1000;
+void PowerSupply::readInputVoltage(double& actualInputVoltage,
+                                   int& inputVoltage) const
+{
+    using namespace phosphor::pmbus;
 
-            // Calculate the voltage based on voltage thresholds
-            if (actualInputVoltage < in_input::VIN_VOLTAGE_MIN)
-            {
-                inputVoltage = in_input::VIN_VOLTAGE_0;
-            }
-            else if (actualInputVoltage < in_input::VIN_VOLTAGE_110_THRESHOLD)
-            {
-                inputVoltage = in_input::VIN_VOLTAGE_110;
-            }
-            else
-            {
-                inputVoltage = in_input::VIN_VOLTAGE_220;
-            }
+    actualInputVoltage = in_input::VIN_VOLTAGE_0;
+    inputVoltage = in_input::VIN_VOLTAGE_0;
+
+    try
+    {
+        // Read input voltage in millivolts
+        std::lock_guard lock{pmbusMutex};
+        auto inputVoltageStr = pmbusIntf->readStringView(READ_VIN, Type::Hwmon);
+
+        // Convert to volts
+        actualInputVoltage = toDouble(inputVoltageStr) / 1000;
+
+        // Calculate the voltage based on voltage thresholds
+        if (actualInputVoltage < in_input::VIN_VOLTAGE_MIN)
+        {
+            inputVoltage = in_input::VIN_VOLTAGE_0;
         }
-        catch (const std::exception& e)
+        else if (actualInputVoltage < in_input::VIN_VOLTAGE_110_THRESHOLD)
         {
-            log<level::ERR>(
-                fmt::format("{} READ_VIN read error: {}", shortName, e.what())
-                    .c_str());
+            inputVoltage = in_input::VIN_VOLTAGE_110;
+        }
+        else
+        {
+            inputVoltage = in_input::VIN_VOLTAGE_220;
         }
     }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("{} READ_VIN read error: {}", shortName, e.what())
+                .c_str());
+    }
 }
 
 void PowerSupply::checkAvailability()
@@ -11,8 +11,16 @@
 #include <gpiod.hpp>
 #include <sdbusplus/bus/match.hpp>
 
+#include <array>
 #include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
 
 namespace phosphor::power::psu
 {
@@ -89,15 +97,106 @@ class PowerSupply
         }
     }
 
+    /**
+     * @brief The PMBus values analyzeStatus() works from, read in one pass.
+     */
+    struct StatusReadings
+    {
+        /** @brief STATUS_WORD, unless reading it failed */
+        std::optional<uint64_t> statusWord;
+
+        /** @brief STATUS_INPUT, STATUS_MFR_SPECIFIC, STATUS_CML, STATUS_VOUT,
+         *         STATUS_IOUT, STATUS_FANS_1_2 and STATUS_TEMPERATURE, in
+         *         that order.  Only read if STATUS_WORD isn't 0. */
+        std::optional<std::array<uint64_t, 7>> statusRegisters;
+
+        /** @brief READ_VIN, in Volts, or 0 if it couldn't be read */
+        double actualInputVoltage = phosphor::pmbus::in_input::VIN_VOLTAGE_0;
+
+        /** @brief The input voltage rounded by the voltage thresholds */
+        int inputVoltage = phosphor::pmbus::in_input::VIN_VOLTAGE_0;
+
+        /** @brief The most recent INPUT_HISTORY record, if read */
+        std::optional<std::vector<uint8_t>> history;
+
+        /** @brief If a read failed and the ones after it were skipped */
+        bool readFailed = false;
+    };
+
     /**
      * Power supply specific function to analyze for faults/errors.
      *
      * Various PMBus status bits will be checked for fault conditions.
      * If a certain fault bits are on, the appropriate error will be
      * committed.
+     *
+     * Same as checkPresence(), then analyzeStatus() with the values read by
+     * getStatusReader() if the power supply is present.
      */
     void analyze();
 
+    /**
+     * @brief Updates the presence from the presence GPIO, if there is one.
+     *
+     * This is the part of analyze() done before the PMBus values are read.
+     */
+    void checkPresence();
+
+    /**
+     * @brief Returns a function that reads the PMBus values analyzeStatus()
+     *        works from.
+     *
+     * The function only uses the PMBus interface, which it locks, and
+     * values copied when it was created, so it can run on a worker thread
+     * while the event loop goes on.  The power supply must outlive it.
+     *
+     * @return The read function
+     */
+    std::function<StatusReadings()> getStatusReader();
+
+    /**
+     * @brief Analyzes the PMBus values read by a status reader for faults,
+     *        and updates D-Bus.
+     *
+     * @param[in] readings - The values read
+     */
+    void analyzeStatus(const StatusReadings& readings);
+
+    /**
+     * @brief Marks that a status reader is running on a worker thread.
+     *
+     * Until readDone() is called, presence and inventory changes that need
+     * the PMBus interface are put off, so the event loop doesn't wait for
+     * the reader to let go of it.
+     */
+    void readStarted()
+    {
+        readInProgress = true;
+    }
+
+    /**
+     * @brief Marks that the status reader is done, and handles the changes
+     *        put off while it ran.
+     */
+    void readDone();
+
+    /**
+     * @brief Counts a status read that didn't finish in time as a failed
+     *        read.
+     *
+     * Nothing is read.  The values from the status reader, once it is
+     * done, aren't used.
+     */
+    void readTimedOut();
+
+    /**
+     * @brief Returns if a status reader is running on a worker thread.
+     */
+    bool isReadInProgress() const
+    {
+        return readInProgress;
+    }
+
     /**
      * Write PMBus ON_OFF_CONFIG
      *
@@ -147,6 +246,17 @@ class PowerSupply
      */
     void clearVinUVFault();
 
+    /**
+     * @brief Opens the hwmon alarm files so they can be polled for changes.
+     *
+     * The PMBus HWMON device driver notifies sysfs pollers when the value
+     * of an alarm file changes.  Alarm files the device doesn't have are
+     * skipped.
+     *
+     * @return The open alarm files.  Empty if the power supply is missing.
+     */
+    std::vector<phosphor::power::util::FileDescriptor> openAlarms();
+
     /**
      * Write PMBus CLEAR_FAULTS
      *
@@ -166,6 +276,10 @@ class PowerSupply
      * This needs to be done on startup, and each time the presence
      * state changes.
      *
+     * Only the interfaces whose properties differ from the last update
+     * are sent, so calling this again for the same power supply doesn't
+     * cause any PropertiesChanged signals.
+     *
      * Properties added:
      * - Serial Number
      * - Part Number
@@ -791,6 +905,19 @@ class PowerSupply
     /** @brief Stored copy of the firmware version/revision string */
     std::string fwVersion;
 
+    /** @brief Inventory properties, by interface */
+    using InventoryInterfaces = std::map<
+        std::string,
+        std::map<std::string,
+                 std::variant<std::string, std::vector<uint8_t>, bool>>>;
+
+    /**
+     * @brief The inventory properties last sent by updateInventory().
+     *
+     * Cleared when the power supply is missing.
+     */
+    InventoryInterfaces publishedInventory;
+
     /**
      * @brief The file system path used for binding the device driver.
      */
@@ -869,9 +996,9 @@ class PowerSupply
     auto getMaxPowerOut() const;
 
     /**
-     * @brief Reads the most recent input history record from the power supply
-     * and updates the average and maximum properties in D-Bus if there is a new
-     * reading available.
+     * @brief Adds the most recent input history record read from the power
+     * supply, and updates the average and maximum properties in D-Bus if
+     * there is a new reading available.
      *
      * This will still run every time analyze() is called so code can post new
      * data as soon as possible and the timestamp will more accurately reflect
@@ -879,8 +1006,53 @@ class PowerSupply
      *
      * D-Bus is only updated if there is a change and the oldest record will be
      * pruned if the property already contains the max number of records.
+     *
+     * @param[in] data - The raw record read from INPUT_HISTORY
+     */
+    void updateHistory(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Reads the PMBus values analyzeStatus() works from.
+     *
+     * @param[in] traceErrors - If read failures should be traced
+     * @param[in] readHistory - If INPUT_HISTORY should be read
+     *
+     * @return The values read
+     */
+    StatusReadings readStatus(bool traceErrors, bool readHistory) const;
+
+    /**
+     * @brief Reads READ_VIN without checking presence, and traces any error.
+     *
+     * @param[out] actualInputVoltage - The voltage read, in Volts
+     * @param[out] inputVoltage - The voltage rounded by the thresholds
+     */
+    void readInputVoltage(double& actualInputVoltage, int& inputVoltage) const;
+
+    /**
+     * @brief Held while the PMBus interface is used, since a status reader
+     * may use it on a worker thread.  Recursive because the functions that
+     * use the interface call each other.
+     */
+    mutable std::recursive_mutex pmbusMutex;
+
+    /**
+     * @brief Runs a function that uses the PMBus interface now, or once the
+     *        status reader is done if one is running.
+     *
+     * @param[in] work - the function
+     */
+    void whenReadDone(std::function<void()> work);
+
+    /**
+     * @brief Set to true while a status reader runs on a worker thread.
+     */
+    bool readInProgress = false;
+
+    /**
+     * @brief The functions put off until the status reader is done.
      */
-    void updateHistory();
+    std::vector<std::function<void()>> readDoneWork;
 
     /**
      * @brief Set to true if INPUT_HISTORY command supported.
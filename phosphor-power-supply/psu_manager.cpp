@@ -5,6 +5,7 @@
 #include "utility.hpp"
 
 #include <fmt/format.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -34,6 +35,8 @@ constexpr auto supportedConfIntf =
 
 constexpr auto INPUT_HISTORY_SYNC_DELAY = 5;
 
+constexpr auto powerSequencerService = "org.openbmc.control.Power";
+
 PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
     bus(bus), powerSystemInputs(bus, powerSystemsInputsObjPath),
     objectManager(bus, objectManagerObjPath),
@@ -49,6 +52,7 @@ PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
                 "xyz.openbmc_project.EntityManager"),
         std::bind(&PSUManager::entityManagerIfaceAdded, this,
                   std::placeholders::_1));
+
     getPSUConfiguration();
     getSystemProperties();
 
@@ -57,13 +61,17 @@ PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
     bus.request_name(managerBusName);
 
     using namespace sdeventplus;
-    auto interval = std::chrono::milliseconds(1000);
     timer = std::make_unique<utility::Timer<ClockId::Monotonic>>(
-        e, std::bind(&PSUManager::analyze, this), interval);
+        e, std::bind(&PSUManager::analyze, this), pollInterval.get());
 
     validationTimer = std::make_unique<utility::Timer<ClockId::Monotonic>>(
         e, std::bind(&PSUManager::validateConfig, this));
 
+    readDeadline = std::make_unique<utility::Timer<ClockId::Monotonic>>(
+        e, std::bind(&PSUManager::readsTimedOut, this));
+
+    readEngine = std::make_unique<util::AsyncEngine>(e);
+
     try
     {
         powerConfigGPIO = createGPIO("power-config-full-load");
@@ -82,6 +90,12 @@ PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
                                                         POWER_IFACE),
         [this](auto& msg) { this->powerStateChanged(msg); });
 
+    // A restarted power sequencer doesn't know the last power supply error
+    powerSequencerMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        sdbusplus::bus::match::rules::nameOwnerChanged(powerSequencerService),
+        [this](auto&) { powerSupplyError.reset(); });
+
     initialize();
 }
 
@@ -148,6 +162,7 @@ void PSUManager::getPSUConfiguration()
     auto objects = getSubTree(bus, "/", IBMCFFPSInterface, depth);
 
     psus.clear();
+    alarmWatches.clear();
 
     // I should get a map of objects back.
     // Each object will have a path, a service, and an interface.
@@ -418,9 +433,11 @@ void PSUManager::powerStateChanged(sdbusplus::message::message& msg)
         int state = std::get<int>(valPropMap->second);
         if (state)
         {
-            // Power on requested
+            // Power on requested.  The power sequencer starts over, so send
+            // it the next power supply error even if it was sent before.
             powerOn = true;
             powerFaultOccurring = false;
+            powerSupplyError.reset();
             validationTimer->restartOnce(validationTimeout);
             clearFaults();
             syncHistory();
@@ -433,6 +450,9 @@ void PSUManager::powerStateChanged(sdbusplus::message::message& msg)
             powerFaultOccurring = false;
             runValidateConfig = true;
         }
+
+        // Faults tend to show up right after a power state change
+        wakePoll();
     }
 
     // Check if it was the pgood property that changed.
@@ -449,6 +469,11 @@ void PSUManager::powerStateChanged(sdbusplus::message::message& msg)
                 powerFaultOccurring = true;
             }
         }
+        else
+        {
+            // Power came back, so a fault seen now is a new one
+            powerSupplyError.reset();
+        }
     }
     log<level::INFO>(
         fmt::format(
@@ -472,6 +497,7 @@ void PSUManager::presenceChanged(sdbusplus::message::message& msg)
             // A PSU became present, force the PSU validation to run.
             runValidateConfig = true;
             validationTimer->restartOnce(validationTimeout);
+            wakePoll();
         }
     }
 }
@@ -479,25 +505,42 @@ void PSUManager::presenceChanged(sdbusplus::message::message& msg)
 void PSUManager::setPowerSupplyError(const std::string& psuErrorString)
 {
     using namespace sdbusplus::xyz::openbmc_project;
-    constexpr auto service = "org.openbmc.control.Power";
     constexpr auto objPath = "/org/openbmc/control/power0";
     constexpr auto interface = "org.openbmc.control.Power";
     constexpr auto method = "setPowerSupplyError";
 
+    if (!powerSupplyError.needsSend(psuErrorString))
+    {
+        return;
+    }
+
+    // Send it again next time if the call fails
+    auto failed = [this, psuErrorString](const std::string& error) {
+        powerSupplyError.failed(psuErrorString);
+        log<level::INFO>(
+            fmt::format("Failed calling setPowerSupplyError due to error {}",
+                        error)
+                .c_str());
+    };
+
     try
     {
-        // Call D-Bus method to inform pseq of PSU error
-        auto methodMsg =
-            bus.new_method_call(service, objPath, interface, method);
+        // Call D-Bus method to inform pseq of PSU error, without waiting for
+        // it to answer
+        auto methodMsg = bus.new_method_call(powerSequencerService, objPath,
+                                             interface, method);
         methodMsg.append(psuErrorString);
-        auto callReply = bus.call(methodMsg);
+        powerSupplyError.sent(psuErrorString);
+        util::callAsync(bus, methodMsg, [failed](auto& reply) {
+            if (reply.is_method_error())
+            {
+                failed(reply.get_error()->name);
+            }
+        });
     }
     catch (const std::exception& e)
     {
-        log<level::INFO>(
-            fmt::format("Failed calling setPowerSupplyError due to error {}",
-                        e.what())
-                .c_str());
+        failed(e.what());
     }
 }
 
@@ -528,8 +571,20 @@ void PSUManager::createError(const std::string& faultName,
         auto level = Logging::server::Entry::Level::Error;
         method.append(faultName, level, additionalData);
 
-        auto reply = bus.call(method);
-        setPowerSupplyError(faultName);
+        // Don't hold up the next analyze() while the logging daemon creates
+        // the entry
+        util::callAsync(bus, method, [this, faultName](auto& reply) {
+            if (reply.is_method_error())
+            {
+                log<level::ERR>(
+                    fmt::format("Failed creating event log for fault {} due "
+                                "to error {}",
+                                faultName, reply.get_error()->name)
+                        .c_str());
+                return;
+            }
+            setPowerSupplyError(faultName);
+        });
     }
     catch (const std::exception& e)
     {
@@ -562,8 +617,91 @@ void PSUManager::syncHistory()
     log<level::INFO>("Synchronize INPUT_HISTORY completed");
 }
 
+void PSUManager::rearmAlarms(const PowerSupply& psu)
+{
+    using namespace sdeventplus::source;
+
+    auto it = alarmWatches.find(&psu);
+    if (it == alarmWatches.end())
+    {
+        return;
+    }
+    auto& watch = it->second;
+
+    // Read the files that changed to wait for their next change.  If that
+    // fails the file went away, likely because the device driver was
+    // unbound, so watchAlarms() will open them all again.
+    for (size_t i = 0; i < watch.sources.size() && !watch.stale; i++)
+    {
+        if (watch.sources[i].get_enabled() == Enabled::Off)
+        {
+            char buffer[16];
+            if (pread(watch.files[i](), buffer, sizeof(buffer), 0) == -1)
+            {
+                watch.stale = true;
+            }
+            else
+            {
+                watch.sources[i].set_enabled(Enabled::On);
+            }
+        }
+    }
+}
+
+void PSUManager::watchAlarms()
+{
+    using namespace sdeventplus::source;
+
+    for (const auto& psu : psus)
+    {
+        // The files are opened with the PMBus interface, which a status
+        // read may still be using.  Try again after the next analyze().
+        if (psu->isReadInProgress())
+        {
+            continue;
+        }
+
+        auto& watch = alarmWatches[psu.get()];
+
+        if (watch.stale || (watch.present != psu->isPresent()))
+        {
+            watch.sources.clear();
+            watch.files = psu->openAlarms();
+            watch.present = psu->isPresent();
+            watch.stale = false;
+
+            watch.sources.reserve(watch.files.size());
+            for (auto& file : watch.files)
+            {
+                watch.sources.emplace_back(
+                    timer->get_event(), file(), EPOLLPRI,
+                    [this](IO& source, int, uint32_t) {
+                        alarmChanged(source);
+                    });
+            }
+        }
+    }
+}
+
+void PSUManager::alarmChanged(sdeventplus::source::IO& source)
+{
+    // The file reports the change until it is read again, which is left to
+    // rearmAlarms() once the status of the power supply has been read.
+    source.set_enabled(sdeventplus::source::Enabled::Off);
+
+    timer->setRemaining(std::chrono::milliseconds(0));
+}
+
 void PSUManager::analyze()
 {
+    // The timer or an alarm can fire again before the last reads are done.
+    // Come back once they are, so an alarm isn't missed.
+    if (!pendingReads.empty())
+    {
+        analyzeAgain = true;
+        return;
+    }
+
     auto syncHistoryRequired =
         std::any_of(psus.begin(), psus.end(), [](const auto& psu) {
             return psu->isSyncHistoryRequired();
@@ -573,11 +711,140 @@ void PSUManager::analyze()
         syncHistory();
     }
 
+    // The fast interval is for the status reads.  Presence is checked at
+    // the normal interval at most.
+    auto now = std::chrono::steady_clock::now();
+    if ((pollInterval.get() != PollInterval::fast) ||
+        (now - lastPresenceCheck >= PollInterval::normal))
+    {
+        lastPresenceCheck = now;
+
+        bool presenceChanged = false;
+        for (auto& psu : psus)
+        {
+            auto wasPresent = psu->isPresent();
+            psu->checkPresence();
+            if (psu->isPresent() != wasPresent)
+            {
+                presenceChanged = true;
+            }
+        }
+
+        if (presenceChanged)
+        {
+            wakePoll();
+        }
+    }
+
+    // Read the power supplies at the same time, so a poll takes about as
+    // long as the slowest one rather than all of them added up
+    std::vector<PowerSupply*> presentPSUs;
     for (auto& psu : psus)
     {
-        psu->analyze();
+        if (!psu->isPresent())
+        {
+            continue;
+        }
+
+        // A read from an earlier poll that is still stuck counts as failed
+        // again, instead of queueing another read behind it
+        if (psu->isReadInProgress())
+        {
+            psu->readTimedOut();
+            continue;
+        }
+
+        presentPSUs.push_back(psu.get());
     }
 
+    if (presentPSUs.empty())
+    {
+        finishAnalyze();
+        return;
+    }
+
+    // Don't let a hung read hold up checking the whole system
+    readDeadline->restartOnce(readTimeout);
+
+    for (auto* psu : presentPSUs)
+    {
+        auto readings = std::make_shared<PowerSupply::StatusReadings>();
+        pendingReads.insert(psu);
+        psu->readStarted();
+        readEngine->submit(
+            psu->getDevicePath(),
+            [reader = psu->getStatusReader(), readings] {
+                *readings = reader();
+            },
+            [this, psu, readings](std::exception_ptr error) {
+                psu->readDone();
+
+                // A read that finished after the deadline was already
+                // counted as failed
+                if (pendingReads.erase(psu) == 0)
+                {
+                    return;
+                }
+
+                // An error analyzing one power supply shouldn't stop the
+                // system from being checked
+                try
+                {
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
+                    }
+
+#if PSU_ALARM_EVENTS
+                    // The status was read, so the alarms can be cleared
+                    rearmAlarms(*psu);
+#endif
+
+                    auto statusWord = psu->getStatusWord();
+                    psu->analyzeStatus(*readings);
+
+                    // Poll fast while a new fault plays out
+                    if ((psu->getStatusWord() & ~statusWord) != 0)
+                    {
+                        wakePoll();
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    log<level::ERR>(fmt::format("{} analyze error: {}",
+                                                psu->getShortName(), e.what())
+                                        .c_str());
+                }
+
+                if (pendingReads.empty())
+                {
+                    readDeadline->setEnabled(false);
+                    finishAnalyze();
+                }
+            });
+    }
+}
+
+void PSUManager::readsTimedOut()
+{
+    for (auto* psu : pendingReads)
+    {
+        log<level::ERR>(fmt::format("{} status read timed out",
+                                    psu->getShortName())
+                            .c_str());
+        psu->readTimedOut();
+    }
+    pendingReads.clear();
+
+    finishAnalyze();
+}
+
+void PSUManager::finishAnalyze()
+{
+#if PSU_ALARM_EVENTS
+    watchAlarms();
+#endif
+
     std::map<std::string, std::string> additionalData;
 
     auto notPresentCount = decltype(psus.size())(
@@ -798,6 +1065,33 @@ void PSUManager::analyze()
             }
         }
     }
+
+    // Poll less often once the power supplies have stayed clean
+    auto clean = std::all_of(psus.begin(), psus.end(), [](const auto& psu) {
+        return !psu->isPresent() || (psu->getStatusWord() == 0);
+    });
+    auto previous = pollInterval.get();
+    if (pollInterval.update(clean) != previous)
+    {
+        timer->restart(pollInterval.get());
+    }
+
+    // Run the analyze() that came in during the reads
+    if (analyzeAgain)
+    {
+        analyzeAgain = false;
+        timer->setRemaining(std::chrono::milliseconds(0));
+    }
+}
+
+void PSUManager::wakePoll()
+{
+    auto previous = pollInterval.get();
+    pollInterval.wake();
+    if (pollInterval.get() != previous)
+    {
+        timer->restart(pollInterval.get());
+    }
 }
 
 void PSUManager::updateMissingPSUs()
@@ -863,7 +1157,8 @@ void PSUManager::updateMissingPSUs()
                 continue;
             }
 
-            if ((presentCount < config.second.powerSupplyCount) && !psuPresent)
+            if ((presentCount < config.second.powerSupplyCount) &&
+                !psuPresent && (propReadFail || presProperty))
             {
                 setPresence(bus, relativeInvPath, psuPresent, psuShortName);
             }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "async_engine.hpp"
+#include "last_sent.hpp"
+#include "poll_interval.hpp"
 #include "power_supply.hpp"
 #include "types.hpp"
 #include "utility.hpp"
@@ -9,9 +12,15 @@
 #include <sdbusplus/server/manager.hpp>
 #include <sdbusplus/server/object.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
 #include <sdeventplus/utility/timer.hpp>
 #include <xyz/openbmc_project/State/Decorator/PowerSystemInputs/server.hpp>
 
+#include <chrono>
+#include <optional>
+#include <set>
+#include <string>
+
 struct sys_properties
 {
     int powerSupplyCount;
@@ -34,6 +43,10 @@ using PowerSystemInputsObject =
 // before performing the validation.
 constexpr auto validationTimeout = std::chrono::seconds(10);
 
+// Time allowed for the power supply status reads of one analyze().  The
+// power supplies that haven't answered by then are counted as failed reads.
+constexpr auto readTimeout = std::chrono::seconds(2);
+
 /**
  * @class PowerSystemInputs
  * @brief A concrete implementation for the PowerSystemInputs interface.
@@ -142,6 +155,8 @@ class PSUManager
 
     /**
      * The timer that runs to periodically check the power supplies.
+     *
+     * Its interval is chosen by pollInterval.
      */
     std::unique_ptr<
         sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
@@ -155,9 +170,20 @@ class PSUManager
         sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
         validationTimer;
 
+    /**
+     * The timer that ends the status reads of an analyze() that take longer
+     * than readTimeout.
+     */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        readDeadline;
+
     /**
      * Let power control/sequencer application know of PSU error(s).
      *
+     * Does nothing if the string is the same as the one last sent.  Doesn't
+     * wait for the call to finish.
+     *
      * @param[in] psuErrorString - string for power supply error
      */
     void setPowerSupplyError(const std::string& psuErrorString);
@@ -165,6 +191,9 @@ class PSUManager
     /**
      * Create an error
      *
+     * Doesn't wait for the logging service to create the entry.  The power
+     * sequencer is told of the error once the entry has been created.
+     *
      * @param[in] faultName - 'name' message for the BMC error log entry
      * @param[in,out] additionalData - The AdditionalData property for the error
      */
@@ -175,9 +204,104 @@ class PSUManager
      * Analyze the status of each of the power supplies.
      *
      * Log errors for faults, when and where appropriate.
+     *
+     * The PMBus values of the power supplies are read at the same time on
+     * worker threads.  Each power supply is analyzed on the event loop when
+     * its values are in, and finishAnalyze() runs once all of them are, or
+     * once readTimeout passes.
+     *
+     * A power supply whose read from an earlier call hasn't finished yet
+     * isn't read again, and is counted as a failed read.
      */
     void analyze();
 
+    /**
+     * Called when the status reads of analyze() take longer than
+     * readTimeout.  Counts the power supplies that haven't answered as
+     * failed reads and finishes the analysis without them.
+     */
+    void readsTimedOut();
+
+    /**
+     * Checks the system as a whole after the power supplies have been
+     * analyzed: brownout, missing and required power supplies, and the
+     * errors to log for power supply faults.  Then picks the interval to
+     * the next poll.
+     */
+    void finishAnalyze();
+
+    /**
+     * Chooses how long to wait between calls to analyze().
+     */
+    PollInterval pollInterval;
+
+    /**
+     * Polls the power supplies fast for the next few cycles, after a
+     * change that may lead to faults.
+     */
+    void wakePoll();
+
+    /**
+     * When analyze() last checked the presence of the power supplies.
+     */
+    std::chrono::steady_clock::time_point lastPresenceCheck;
+
+    /**
+     * @brief The hwmon alarm files being watched for a power supply.
+     */
+    struct AlarmWatch
+    {
+        /** @brief If the power supply was present when the files were opened
+         */
+        bool present = false;
+
+        /** @brief If the files need to be opened again */
+        bool stale = true;
+
+        /** @brief The open alarm files */
+        std::vector<phosphor::power::util::FileDescriptor> files;
+
+        /** @brief The event sources for the files, in the same order */
+        std::vector<sdeventplus::source::IO> sources;
+    };
+
+    /**
+     * @brief The alarm files being watched for each power supply.
+     *
+     * Only used when PSU_ALARM_EVENTS is enabled.
+     */
+    std::map<const PowerSupply*, AlarmWatch> alarmWatches;
+
+    /**
+     * @brief Reads the hwmon alarm files of a power supply that changed
+     *        since the last call, so that they will report the next change.
+     *
+     * Reading an alarm file can clear the latched STATUS_* bits behind it,
+     * so this is only done once the status registers of the power supply
+     * have been read, and the faults they latched have been seen.
+     *
+     * @param[in] psu - the power supply
+     */
+    void rearmAlarms(const PowerSupply& psu);
+
+    /**
+     * @brief Updates the hwmon alarm files being watched.
+     *
+     * Starts watching the alarm files of power supplies that were just
+     * added, plugged in, or had their device driver rebound.  The files
+     * that are already watched aren't read.
+     */
+    void watchAlarms();
+
+    /**
+     * @brief Callback for a change to a hwmon alarm file.
+     *
+     * Runs analyze() right away instead of waiting for the next poll.
+     *
+     * @param[in] source - the event source for the alarm file
+     */
+    void alarmChanged(sdeventplus::source::IO& source);
+
     /** @brief True if the power is on. */
     bool powerOn = false;
 
@@ -188,12 +312,21 @@ class PSUManager
     /** @brief True if an error for a brownout has already been logged. */
     bool brownoutLogged = false;
 
+    /**
+     * @brief The error string last sent by setPowerSupplyError(), until the
+     *        power sequencer may have forgotten it.
+     */
+    LastSent<std::string> powerSupplyError;
+
     /** @brief Used as part of subscribing to power on state changes*/
     std::string powerService;
 
     /** @brief Used to subscribe to D-Bus power on state changes */
     std::unique_ptr<sdbusplus::bus::match_t> powerOnMatch;
 
+    /** @brief Used to notice the power sequencer restarting */
+    std::unique_ptr<sdbusplus::bus::match_t> powerSequencerMatch;
+
     /** @brief Used to subscribe to D-Bus power supply presence changes */
     std::vector<std::unique_ptr<sdbusplus::bus::match_t>> presenceMatches;
 
@@ -388,6 +521,26 @@ class PSUManager
      * start fresh.
      */
     void syncHistory();
+
+    /**
+     * @brief The power supplies whose PMBus values are still being read for
+     * the current analyze().
+     */
+    std::set<PowerSupply*> pendingReads;
+
+    /**
+     * @brief Whether analyze() was called while the reads were pending, so
+     * the power supplies are analyzed again once they are done.
+     */
+    bool analyzeAgain = false;
+
+    /**
+     * @brief Runs the PMBus reads of analyze() on worker threads.
+     *
+     * Declared last so it is destroyed first, while the power supplies the
+     * reads use still exist.
+     */
+    std::unique_ptr<util::AsyncEngine> readEngine;
 };
 
 } // namespace phosphor::power::manager
@@ -0,0 +1,50 @@
+#include "../last_sent.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::manager;
+
+TEST(LastSentTests, Dedupe)
+{
+    LastSent<std::string> last;
+    EXPECT_TRUE(last.needsSend("fault"));
+
+    last.sent("fault");
+    EXPECT_FALSE(last.needsSend("fault"));
+    EXPECT_TRUE(last.needsSend("other fault"));
+
+    last.sent("other fault");
+    EXPECT_TRUE(last.needsSend("fault"));
+    EXPECT_FALSE(last.needsSend("other fault"));
+}
+
+TEST(LastSentTests, Failed)
+{
+    LastSent<std::string> last;
+    last.sent("fault");
+
+    // Failing a value sent before the last one keeps the last one
+    last.sent("other fault");
+    last.failed("fault");
+    EXPECT_FALSE(last.needsSend("other fault"));
+
+    last.failed("other fault");
+    EXPECT_TRUE(last.needsSend("other fault"));
+}
+
+TEST(LastSentTests, PowerCycle)
+{
+    LastSent<std::string> last;
+
+    // A fault is sent once while it stays on
+    last.sent("fault");
+    EXPECT_FALSE(last.needsSend("fault"));
+
+    // After a power cycle the same fault is sent again
+    last.reset();
+    EXPECT_TRUE(last.needsSend("fault"));
+    last.sent("fault");
+    EXPECT_FALSE(last.needsSend("fault"));
+}
@@ -34,6 +34,17 @@ class MockedPMBus : public PMBusBase
     MOCK_METHOD(const fs::path&, path, (), (const, override));
     MOCK_METHOD(std::string, insertPageNum,
                 (const std::string& templateName, size_t page), (override));
+
+    // Tests set expectations on readString(), which this is built on
+    std::string_view readStringView(const std::string& name,
+                                    Type type) override
+    {
+        stringValue = readString(name, type);
+        return stringValue;
+    }
+
+  private:
+    std::string stringValue;
 };
 } // namespace pmbus
 
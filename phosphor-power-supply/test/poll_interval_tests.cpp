@@ -0,0 +1,61 @@
+#include "../poll_interval.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::manager;
+
+TEST(PollIntervalTests, Settle)
+{
+    PollInterval poll;
+    EXPECT_EQ(poll.get(), PollInterval::normal);
+
+    // Goes idle once enough polls in a row are clean
+    for (size_t i = 1; i < PollInterval::idleCycles; i++)
+    {
+        EXPECT_EQ(poll.update(true), PollInterval::normal);
+    }
+    EXPECT_EQ(poll.update(true), PollInterval::idle);
+    EXPECT_EQ(poll.update(true), PollInterval::idle);
+    EXPECT_EQ(poll.get(), PollInterval::idle);
+
+    // A fault starts the count over
+    EXPECT_EQ(poll.update(false), PollInterval::normal);
+    EXPECT_EQ(poll.update(true), PollInterval::normal);
+}
+
+TEST(PollIntervalTests, Wake)
+{
+    PollInterval poll;
+    for (size_t i = 0; i < PollInterval::idleCycles; i++)
+    {
+        poll.update(true);
+    }
+    EXPECT_EQ(poll.get(), PollInterval::idle);
+
+    poll.wake();
+    EXPECT_EQ(poll.get(), PollInterval::fast);
+
+    // The wake poll and the ones after it are fast
+    for (size_t i = 1; i < PollInterval::fastCycles; i++)
+    {
+        EXPECT_EQ(poll.update(true), PollInterval::fast);
+    }
+
+    // Then normal until the power supplies have stayed clean
+    EXPECT_EQ(poll.update(true), PollInterval::normal);
+    for (size_t i = PollInterval::fastCycles + 1; i < PollInterval::idleCycles;
+         i++)
+    {
+        EXPECT_EQ(poll.update(true), PollInterval::normal);
+    }
+    EXPECT_EQ(poll.update(true), PollInterval::idle);
+
+    // A fault that doesn't go away doesn't keep the polls fast
+    poll.wake();
+    for (size_t i = 1; i < PollInterval::fastCycles; i++)
+    {
+        EXPECT_EQ(poll.update(false), PollInterval::fast);
+    }
+    EXPECT_EQ(poll.update(false), PollInterval::normal);
+    EXPECT_EQ(poll.update(false), PollInterval::normal);
+}
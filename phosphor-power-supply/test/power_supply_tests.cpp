@@ -10,6 +10,7 @@
 
 using namespace phosphor::power::psu;
 using namespace phosphor::pmbus;
+using sdbusplus::xyz::openbmc_project::Common::Device::Error::ReadFailure;
 
 using ::testing::_;
 using ::testing::Args;
@@ -19,6 +20,7 @@ using ::testing::ElementsAre;
 using ::testing::NotNull;
 using ::testing::Return;
 using ::testing::StrEq;
+using ::testing::Throw;
 
 static auto PSUInventoryPath = "/xyz/bmc/inv/sys/chassis/board/powersupply0";
 static auto PSUGPIOLineName = "presence-ps0";
@@ -57,10 +59,7 @@ void setPMBusExpectations(MockedPMBus& mockPMBus,
         EXPECT_CALL(mockPMBus, read(STATUS_CML, _, _))
             .Times(1)
             .WillOnce(Return(expectations.statusCMLValue));
-        // Page will need to be set to 0 to read STATUS_VOUT.
-        EXPECT_CALL(mockPMBus, insertPageNum(STATUS_VOUT, 0))
-            .Times(1)
-            .WillOnce(Return("status0_vout"));
+        // STATUS_VOUT is read from page 0.
         EXPECT_CALL(mockPMBus, read("status0_vout", _, _))
             .Times(1)
             .WillOnce(Return(expectations.statusVOUTValue));
@@ -2205,3 +2204,124 @@ TEST_F(PowerSupplyTests, IsSyncHistoryRequired)
     psu.clearSyncHistoryRequired();
     EXPECT_EQ(psu.isSyncHistoryRequired(), false);
 }
+
+TEST_F(PowerSupplyTests, StatusReader)
+{
+    auto bus = sdbusplus::bus::new_default();
+
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, true)).Times(1);
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, false)).Times(0);
+
+    PowerSupply psu{bus,  PSUInventoryPath, 3,
+                    0x6a, "ibm-cffps",      PSUGPIOLineName};
+    MockedGPIOInterface* mockPresenceGPIO =
+        static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+    // Always return 1 to indicate present.
+    EXPECT_CALL(*mockPresenceGPIO, read()).WillRepeatedly(Return(1));
+    MockedPMBus& mockPMBus = static_cast<MockedPMBus&>(psu.getPMBus());
+    setMissingToPresentExpects(mockPMBus, mockedUtil);
+    // Missing/present will trigger attempt to setup INPUT_HISTORY. Setup
+    // for INPUT_HISTORY will check max_power_out to see if it is
+    // old/unsupported power supply. Indicate good value, supported.
+    EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+        .Times(1)
+        .WillOnce(Return("2000"));
+    psu.checkPresence();
+    EXPECT_EQ(psu.isPresent(), true);
+
+    // The reader does all the reads, but nothing changes until the values
+    // are analyzed.
+    PMBusExpectations expectations;
+    expectations.statusWordValue = (status_word::TEMPERATURE_FAULT_WARN);
+    // STATUS_TEMPERATURE fault bit on (OT Fault)
+    expectations.statusTempValue = 0x80;
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(1)
+        .WillOnce(Return("206100"));
+    auto reader = psu.getStatusReader();
+    auto readings = reader();
+    ASSERT_TRUE(readings.statusWord.has_value());
+    EXPECT_EQ(*readings.statusWord, status_word::TEMPERATURE_FAULT_WARN);
+    ASSERT_TRUE(readings.statusRegisters.has_value());
+    EXPECT_EQ((*readings.statusRegisters)[6], 0x80);
+    EXPECT_DOUBLE_EQ(readings.actualInputVoltage, 206.1);
+    EXPECT_EQ(readings.inputVoltage, in_input::VIN_VOLTAGE_220);
+    EXPECT_TRUE(readings.history.has_value());
+    EXPECT_EQ(readings.readFailed, false);
+    EXPECT_EQ(psu.getStatusWord(), 0);
+
+    // Analyzing the values doesn't read them again.  The first time, the
+    // voltage going from 0 to in range clears VIN_UV faults.
+    for (auto x = 1; x <= DEGLITCH_LIMIT; x++)
+    {
+        psu.analyzeStatus(readings);
+        EXPECT_EQ(psu.hasTempFault(), x >= DEGLITCH_LIMIT);
+    }
+    EXPECT_EQ(psu.getStatusWord(), status_word::TEMPERATURE_FAULT_WARN);
+    EXPECT_EQ(psu.getStatusTemperature(), 0x80);
+
+    // Nothing after a failed read is read, or changed when analyzed
+    EXPECT_CALL(mockPMBus, read(STATUS_WORD, _, _))
+        .Times(1)
+        .WillOnce(Throw(ReadFailure()));
+    readings = reader();
+    EXPECT_FALSE(readings.statusWord.has_value());
+    EXPECT_FALSE(readings.history.has_value());
+    EXPECT_EQ(readings.readFailed, true);
+    psu.analyzeStatus(readings);
+    EXPECT_EQ(psu.getStatusWord(), status_word::TEMPERATURE_FAULT_WARN);
+    EXPECT_EQ(psu.hasTempFault(), true);
+}
+
+TEST_F(PowerSupplyTests, ReadInProgress)
+{
+    auto bus = sdbusplus::bus::new_default();
+
+    PowerSupply psu{bus,  PSUInventoryPath, 3,
+                    0x68, "ibm-cffps",      PSUGPIOLineName};
+    MockedGPIOInterface* mockPresenceGPIO =
+        static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+    // Always return 1 to indicate present.
+    EXPECT_CALL(*mockPresenceGPIO, read()).WillRepeatedly(Return(1));
+    MockedPMBus& mockPMBus = static_cast<MockedPMBus&>(psu.getPMBus());
+
+    // While a status read runs, the power supply is seen being plugged in,
+    // but it isn't set up and nothing is read until the read is done.
+    EXPECT_CALL(mockPMBus, findHwmonDir()).Times(0);
+    EXPECT_CALL(mockPMBus, readString(_, _)).Times(0);
+    EXPECT_CALL(mockedUtil, setPresence(_, _, _, _)).Times(0);
+    psu.readStarted();
+    EXPECT_EQ(psu.isReadInProgress(), true);
+    psu.checkPresence();
+    EXPECT_EQ(psu.isPresent(), true);
+
+    double actualInputVoltage;
+    int inputVoltage;
+    psu.getInputVoltage(actualInputVoltage, inputVoltage);
+    EXPECT_EQ(inputVoltage, in_input::VIN_VOLTAGE_0);
+    ::testing::Mock::VerifyAndClearExpectations(&mockPMBus);
+
+    // The power supply is set up once the read is done
+    EXPECT_CALL(mockPMBus, findHwmonDir());
+    EXPECT_CALL(mockPMBus, writeBinary(ON_OFF_CONFIG, _, _));
+    EXPECT_CALL(mockPMBus, read(READ_VIN, _, _)).Times(1).WillOnce(Return(1));
+    EXPECT_CALL(mockPMBus, read("in1_lcrit_alarm", _, _))
+        .Times(1)
+        .WillOnce(Return(1));
+    EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+        .Times(1)
+        .WillOnce(Return("2000"));
+    EXPECT_CALL(mockedUtil, setPresence(_, _, true, _));
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, true));
+    psu.readDone();
+    EXPECT_EQ(psu.isReadInProgress(), false);
+
+    // Reads that don't finish in time count as failed reads
+    for (auto x = 1; x <= LOG_LIMIT; x++)
+    {
+        EXPECT_EQ(psu.hasCommFault(), false);
+        psu.readTimedOut();
+    }
+    EXPECT_EQ(psu.hasCommFault(), true);
+}
@@ -19,12 +19,16 @@
 #include "phase_fault.hpp"
 #include "services.hpp"
 
+#include <algorithm>
 #include <cstddef> // for size_t
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace phosphor::power::regulators
 {
@@ -46,6 +50,7 @@ class Rule;
  *   - reference to system services
  *   - faults detected by actions (if any)
  *   - additional error data captured by actions (if any)
+ *   - binary device data captured by actions (if any)
  */
 class ActionEnvironment
 {
@@ -63,6 +68,13 @@ class ActionEnvironment
      */
     static constexpr size_t maxRuleDepth{30};
 
+    /**
+     * Number of bytes reserved for captured device data when the first bytes
+     * are captured.  Large enough for the captures done for a typical device
+     * fault so the buffer does not have to grow.
+     */
+    static constexpr size_t capturedBytesCapacity{4096};
+
     /**
      * Constructor.
      *
@@ -92,6 +104,41 @@ class ActionEnvironment
         additionalErrorData.emplace(key, value);
     }
 
+    /**
+     * Adds the specified bytes read from the current device to the binary
+     * device data that has been captured.
+     *
+     * This data provides more information about an error and will be stored in
+     * the error log as a binary FFDC file rather than as strings.
+     *
+     * The bytes are stored as a record with the following format:
+     *   - device ID length (1 byte)
+     *   - device ID (without a null terminator, truncated to 255 bytes)
+     *   - device register address (1 byte)
+     *   - byte count (1 byte)
+     *   - bytes in the order they were read from the device
+     *
+     * @param reg device register address of the first byte
+     * @param bytes bytes read from the device; at most 255
+     */
+    void addCapturedBytes(uint8_t reg, std::span<const uint8_t> bytes)
+    {
+        if (capturedBytes.capacity() == 0)
+        {
+            capturedBytes.reserve(capturedBytesCapacity);
+        }
+
+        size_t idLength = std::min(deviceID.size(), size_t{UINT8_MAX});
+        size_t count = std::min(bytes.size(), size_t{UINT8_MAX});
+        capturedBytes.push_back(static_cast<uint8_t>(idLength));
+        capturedBytes.insert(capturedBytes.end(), deviceID.begin(),
+                             deviceID.begin() + idLength);
+        capturedBytes.push_back(reg);
+        capturedBytes.push_back(static_cast<uint8_t>(count));
+        capturedBytes.insert(capturedBytes.end(), bytes.begin(),
+                             bytes.begin() + count);
+    }
+
     /**
      * Adds the specified phase fault to the set of faults that have been
      * detected.
@@ -127,6 +174,18 @@ class ActionEnvironment
         return additionalErrorData;
     }
 
+    /**
+     * Returns the binary device data that has been captured (if any).
+     *
+     * See addCapturedBytes() for the format of the data.
+     *
+     * @return captured device data
+     */
+    const std::vector<uint8_t>& getCapturedBytes() const
+    {
+        return capturedBytes;
+    }
+
     /**
      * Returns the device with the current device ID.
      *
@@ -280,6 +339,11 @@ class ActionEnvironment
      * Additional error data that has been captured.
      */
     std::map<std::string, std::string> additionalErrorData{};
+
+    /**
+     * Binary device data that has been captured.
+     */
+    std::vector<uint8_t> capturedBytes{};
 };
 
 } // namespace phosphor::power::regulators
@@ -19,8 +19,12 @@
 #include "action_error.hpp"
 #include "i2c_interface.hpp"
 
+#include <linux/i2c.h>
+
+#include <array>
 #include <exception>
 #include <ios>
+#include <span>
 #include <sstream>
 
 namespace phosphor::power::regulators
@@ -30,17 +34,42 @@ bool I2CCaptureBytesAction::execute(ActionEnvironment& environment)
 {
     try
     {
-        // Read device register values.  Use I2C mode where the number of bytes
-        // to read is explicitly specified.
         i2c::I2CInterface& interface = getI2CInterface(environment);
-        uint8_t size{count}; // byte count parameter is input/output
         uint8_t values[UINT8_MAX];
-        interface.read(reg, size, values, i2c::I2CInterface::Mode::I2C);
+        if (binary)
+        {
+            // Read the register range in block reads and store the bytes in
+            // the action environment as they are, without formatting them
+            std::span<uint8_t> bytes{values, count};
+            interface.readRange(reg, bytes);
+            environment.addCapturedBytes(reg, bytes);
+        }
+        else
+        {
+            // Read device register values.  Use I2C mode where the number of
+            // bytes to read is explicitly specified.
+            uint8_t size{count}; // byte count parameter is input/output
+            if (count <= I2C_SMBUS_BLOCK_MAX)
+            {
+                interface.read(reg, size, values,
+                               i2c::I2CInterface::Mode::I2C);
+            }
+            else
+            {
+                // SMBus block reads are limited to 32 bytes, so write the
+                // register and read all the bytes in one combined transaction
+                std::array<i2c::I2CInterface::Message, 2> messages{
+                    i2c::I2CInterface::Message::write(&reg, 1),
+                    i2c::I2CInterface::Message::read(values, count)};
+                interface.transfer(messages);
+            }
 
-        // Store error data in action environment as a string key/value pair
-        std::string key = getErrorDataKey(environment);
-        std::string value = getErrorDataValue(values);
-        environment.addAdditionalErrorData(key, value);
+            // Store error data in action environment as a string key/value
+            // pair
+            std::string key = getErrorDataKey(environment);
+            std::string value = getErrorDataValue(values);
+            environment.addAdditionalErrorData(key, value);
+        }
     }
     catch (const i2c::I2CException& e)
     {
@@ -56,7 +85,12 @@ std::string I2CCaptureBytesAction::toString() const
     std::ostringstream ss;
     ss << "i2c_capture_bytes: { register: 0x" << std::hex << std::uppercase
        << static_cast<uint16_t>(reg) << ", count: " << std::dec
-       << static_cast<uint16_t>(count) << " }";
+       << static_cast<uint16_t>(count);
+    if (binary)
+    {
+        ss << ", binary: true";
+    }
+    ss << " }";
     return ss.str();
 }
 
@@ -52,9 +52,12 @@ class I2CCaptureBytesAction : public I2CAction
      * @param reg Device register address.  Note: named 'reg' because 'register'
      *            is a reserved keyword.
      * @param count Number of bytes to read from the device register.
+     * @param binary Specifies whether to store the bytes as binary data
+     *               rather than as a hex string.
      */
-    explicit I2CCaptureBytesAction(uint8_t reg, uint8_t count) :
-        reg{reg}, count{count}
+    explicit I2CCaptureBytesAction(uint8_t reg, uint8_t count,
+                                   bool binary = false) :
+        reg{reg}, count{count}, binary{binary}
     {
         if (count < 1)
         {
@@ -71,6 +74,10 @@ class I2CCaptureBytesAction : public I2CAction
      *
      * All of the bytes will be read in a single I2C operation.
      *
+     * If binary is true, the bytes are instead read from consecutive device
+     * registers in I2C block reads of up to 32 bytes, and are stored as
+     * captured bytes in the action environment without being formatted.
+     *
      * The device register was specified in the constructor.
      *
      * The device is obtained from the action environment.
@@ -102,6 +109,17 @@ class I2CCaptureBytesAction : public I2CAction
         return reg;
     }
 
+    /**
+     * Returns whether the bytes are stored as binary data rather than as a hex
+     * string.
+     *
+     * @return true if the bytes are stored as binary data
+     */
+    bool isBinary() const
+    {
+        return binary;
+    }
+
     /**
      * Returns a string description of this action.
      *
@@ -139,6 +157,12 @@ class I2CCaptureBytesAction : public I2CAction
      * Number of bytes to read from the device register.
      */
     const uint8_t count;
+
+    /**
+     * Specifies whether to store the bytes as binary data rather than as a hex
+     * string.
+     */
+    const bool binary;
 };
 
 } // namespace phosphor::power::regulators
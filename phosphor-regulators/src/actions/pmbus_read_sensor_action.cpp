@@ -21,6 +21,7 @@
 
 #include <sdbusplus/exception.hpp>
 
+#include <array>
 #include <exception>
 #include <ios>
 #include <sstream>
@@ -35,10 +36,21 @@ bool PMBusReadSensorAction::execute(ActionEnvironment& environment)
         // Get I2C interface to current device
         i2c::I2CInterface& interface = getI2CInterface(environment);
 
-        // Read two byte value of PMBus command code.  I2CInterface method reads
-        // low byte first as required by PMBus.
         uint16_t value{0x00};
-        interface.read(command, value);
+        uint8_t voutModeValue{0x00};
+        if ((format == pmbus_utils::SensorDataFormat::linear_16) &&
+            !exponent.has_value())
+        {
+            // The exponent comes from VOUT_MODE, so read it along with the
+            // sensor value
+            value = readWithVoutMode(interface, voutModeValue);
+        }
+        else
+        {
+            // Read two byte value of PMBus command code.  I2CInterface method
+            // reads low byte first as required by PMBus.
+            interface.read(command, value);
+        }
 
         // Convert two byte PMBus value into a decimal sensor value
         double sensorValue{0.0};
@@ -48,7 +60,8 @@ bool PMBusReadSensorAction::execute(ActionEnvironment& environment)
                 sensorValue = pmbus_utils::convertFromLinear(value);
                 break;
             case pmbus_utils::SensorDataFormat::linear_16:
-                int8_t exponentValue = getExponentValue(environment, interface);
+                int8_t exponentValue =
+                    getExponentValue(environment, voutModeValue);
                 sensorValue =
                     pmbus_utils::convertFromVoutLinear(value, exponentValue);
                 break;
@@ -95,7 +108,7 @@ std::string PMBusReadSensorAction::toString() const
 }
 
 int8_t PMBusReadSensorAction::getExponentValue(ActionEnvironment& environment,
-                                               i2c::I2CInterface& interface)
+                                               uint8_t voutModeValue)
 {
     // Check if an exponent value is defined for this action
     if (exponent.has_value())
@@ -103,10 +116,6 @@ int8_t PMBusReadSensorAction::getExponentValue(ActionEnvironment& environment,
         return exponent.value();
     }
 
-    // Read value of the VOUT_MODE command
-    uint8_t voutModeValue;
-    interface.read(pmbus_utils::VOUT_MODE, voutModeValue);
-
     // Parse VOUT_MODE value to get data format and parameter value
     pmbus_utils::VoutDataFormat format;
     int8_t parameter;
@@ -124,4 +133,32 @@ int8_t PMBusReadSensorAction::getExponentValue(ActionEnvironment& environment,
     return parameter;
 }
 
+uint16_t PMBusReadSensorAction::readWithVoutMode(i2c::I2CInterface& interface,
+                                                 uint8_t& voutModeValue)
+{
+    if (!interface.canTransfer())
+    {
+        // Read them in separate SMBus transactions, which are checked with
+        // PEC if it is enabled
+        uint16_t value{0x00};
+        interface.read(pmbus_utils::VOUT_MODE, voutModeValue);
+        interface.read(command, value);
+        return value;
+    }
+
+    // Read VOUT_MODE and then the two byte value of the PMBus command code,
+    // which is sent low byte first as required by PMBus, in one combined
+    // transaction
+    const uint8_t voutModeCommand{pmbus_utils::VOUT_MODE};
+    std::array<uint8_t, 2> bytes{};
+    std::array<i2c::I2CInterface::Message, 4> messages{
+        i2c::I2CInterface::Message::write(&voutModeCommand, 1),
+        i2c::I2CInterface::Message::read(&voutModeValue, 1),
+        i2c::I2CInterface::Message::write(&command, 1),
+        i2c::I2CInterface::Message::read(bytes.data(), bytes.size())};
+    interface.transfer(messages);
+
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
 } // namespace phosphor::power::regulators
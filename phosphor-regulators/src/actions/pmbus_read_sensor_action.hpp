@@ -153,17 +153,33 @@ class PMBusReadSensorAction : public I2CAction
      * decimal volts value.
      *
      * If an exponent value is defined for this action, that value is returned.
-     * Otherwise VOUT_MODE is read from the current device to obtain the
-     * exponent value.
+     * Otherwise the exponent value is obtained from the VOUT_MODE value read
+     * from the current device.
      *
      * Throws an exception if an error occurs.
      *
      * @param environment action execution environment
-     * @param interface I2C interface to the current device
+     * @param voutModeValue VOUT_MODE value read from the current device
      * @return exponent value
      */
     int8_t getExponentValue(ActionEnvironment& environment,
-                            i2c::I2CInterface& interface);
+                            uint8_t voutModeValue);
+
+    /**
+     * Reads VOUT_MODE and the value of the PMBus command code from the
+     * current device.
+     *
+     * They are read in one combined I2C transaction if the interface can do
+     * one, else in two SMBus transactions, like when PEC is enabled.
+     *
+     * Throws an exception if an error occurs.
+     *
+     * @param interface I2C interface to the current device
+     * @param voutModeValue VOUT_MODE value read from the device
+     * @return value of the PMBus command code
+     */
+    uint16_t readWithVoutMode(i2c::I2CInterface& interface,
+                              uint8_t& voutModeValue);
 
     /**
      * Sensor type.
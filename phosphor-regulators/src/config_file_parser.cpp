@@ -18,6 +18,7 @@
 
 #include "config_file_parser_error.hpp"
 #include "i2c_interface.hpp"
+#include "i2c_scheduler.hpp"
 #include "pmbus_utils.hpp"
 
 #include <exception>
@@ -469,10 +470,19 @@ std::unique_ptr<I2CCaptureBytesAction> parseI2CCaptureBytes(const json& element)
     }
     ++propertyCount;
 
+    // Optional binary property
+    bool binary = false;
+    auto binaryIt = element.find("binary");
+    if (binaryIt != element.end())
+    {
+        binary = parseBoolean(*binaryIt);
+        ++propertyCount;
+    }
+
     // Verify no invalid properties exist
     verifyPropertyCount(element, propertyCount);
 
-    return std::make_unique<I2CCaptureBytesAction>(reg, count);
+    return std::make_unique<I2CCaptureBytesAction>(reg, count, binary);
 }
 
 std::unique_ptr<I2CCompareBitAction> parseI2CCompareBit(const json& element)
@@ -586,13 +596,70 @@ std::unique_ptr<i2c::I2CInterface> parseI2CInterface(const json& element)
     uint8_t address = parseHexByte(addressElement);
     ++propertyCount;
 
+    // Optional pec property
+    bool pec = false;
+    auto pecIt = element.find("pec");
+    if (pecIt != element.end())
+    {
+        pec = parseBoolean(*pecIt);
+        ++propertyCount;
+    }
+
+    // Optional bus_clock_rate property
+    std::optional<unsigned int> clockRate{};
+    auto clockRateIt = element.find("bus_clock_rate");
+    if (clockRateIt != element.end())
+    {
+        clockRate = parseUnsignedInteger(*clockRateIt);
+        if (*clockRate == 0)
+        {
+            throw std::invalid_argument{"Invalid bus clock rate: Must be > 0"};
+        }
+        ++propertyCount;
+    }
+
+    // Optional bus_duty_cycle_limit property
+    std::optional<double> dutyCycleLimit{};
+    auto dutyCycleLimitIt = element.find("bus_duty_cycle_limit");
+    if (dutyCycleLimitIt != element.end())
+    {
+        dutyCycleLimit = parseDouble(*dutyCycleLimitIt);
+        if ((*dutyCycleLimit <= 0.0) || (*dutyCycleLimit > 1.0))
+        {
+            throw std::invalid_argument{
+                "Invalid bus duty cycle limit: Must be > 0 and <= 1"};
+        }
+        ++propertyCount;
+    }
+
     // Verify no invalid properties exist
     verifyPropertyCount(element, propertyCount);
 
-    // Create I2CInterface object; retry failed I2C operations a max of 3 times.
+    // The clock rate and duty cycle limit apply to every device on the bus
+    if (clockRate)
+    {
+        i2c::BusScheduler::get().setClockRate(bus, *clockRate);
+    }
+    if (dutyCycleLimit)
+    {
+        i2c::BusScheduler::get().setDutyCycleLimit(bus, *dutyCycleLimit);
+    }
+
+    // Create I2CInterface object; retry failed I2C operations a max of 3 times
+    // with backoff.  Park the device for a while after 5 operations in a row
+    // fail so it doesn't slow down monitoring of the other devices.
     int maxRetries{3};
-    return i2c::create(bus, address, i2c::I2CInterface::InitialState::CLOSED,
-                       maxRetries);
+    int failureBudget{5};
+    std::unique_ptr<i2c::I2CInterface> interface = i2c::create(
+        bus, address, i2c::I2CInterface::InitialState::CLOSED, maxRetries);
+    interface->setRetryPolicy(std::make_shared<i2c::BackoffRetryPolicy>(
+        maxRetries, i2c::BackoffRetryPolicy::defaultInitialDelay,
+        i2c::BackoffRetryPolicy::defaultMaxDelay, failureBudget));
+    if (pec)
+    {
+        interface->setPEC(true);
+    }
+    return interface;
 }
 
 std::unique_ptr<I2CWriteBitAction> parseI2CWriteBit(const json& element)
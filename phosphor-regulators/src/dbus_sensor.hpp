@@ -176,6 +176,18 @@ class DBusSensor
         return type;
     }
 
+    /**
+     * Keep this sensor in its current state.
+     *
+     * Used when the sensor was not read during a monitoring cycle for a reason
+     * other than an error.  Marks the sensor as updated so it is not removed
+     * at the end of the cycle.
+     */
+    void keep()
+    {
+        setLastUpdateTime();
+    }
+
     /**
      * Set this sensor to the error state.
      *
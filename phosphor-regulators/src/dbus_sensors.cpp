@@ -99,6 +99,24 @@ void DBusSensors::setValue(SensorType type, double value)
     }
 }
 
+void DBusSensors::skipRail()
+{
+    // Keep the sensors for current rail so they aren't deleted at the end of
+    // the cycle
+    for (auto& [sensorName, sensor] : sensors)
+    {
+        if (sensor->getRail() == rail)
+        {
+            sensor->keep();
+        }
+    }
+
+    // Clear current rail information
+    rail.clear();
+    deviceInventoryPath.clear();
+    chassisInventoryPath.clear();
+}
+
 void DBusSensors::startCycle()
 {
     // Store the time when this monitoring cycle started.  This is used to
@@ -69,6 +69,9 @@ class DBusSensors : public Sensors
     /** @copydoc Sensors::setValue() */
     virtual void setValue(SensorType type, double value) override;
 
+    /** @copydoc Sensors::skipRail() */
+    virtual void skipRail() override;
+
     /** @copydoc Sensors::startCycle() */
     virtual void startCycle() override;
 
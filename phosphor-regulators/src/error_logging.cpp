@@ -17,6 +17,7 @@
 #include "error_logging.hpp"
 
 #include "exception_utils.hpp"
+#include "i2c_trace.hpp"
 
 #include <errno.h>     // for errno
 #include <string.h>    // for strerror()
@@ -33,6 +34,44 @@
 namespace phosphor::power::regulators
 {
 
+namespace
+{
+
+/**
+ * Format subtype and version of the FFDC file containing binary device data.
+ * See ActionEnvironment::addCapturedBytes() for the format of the data.
+ */
+constexpr uint8_t capturedBytesSubType{1};
+constexpr uint8_t capturedBytesVersion{1};
+
+/**
+ * Writes the specified bytes to a file descriptor.
+ *
+ * Throws an exception if an error occurs.
+ *
+ * @param fd file descriptor
+ * @param data bytes to write
+ * @param count number of bytes to write
+ */
+void writeAll(int fd, const char* data, size_t count)
+{
+    while (count > 0)
+    {
+        // Try to write remaining bytes; it might not write all of them
+        ssize_t bytesWritten = write(fd, data, count);
+        if (bytesWritten == -1)
+        {
+            throw std::runtime_error{
+                std::string{"Unable to write to FFDC file: "} +
+                strerror(errno)};
+        }
+        data += bytesWritten;
+        count -= bytesWritten;
+    }
+}
+
+} // namespace
+
 void DBusErrorLogging::logConfigFileError(Entry::Level severity,
                                           Journal& journal)
 {
@@ -89,14 +128,15 @@ void DBusErrorLogging::logInternalError(Entry::Level severity, Journal& journal)
 void DBusErrorLogging::logPhaseFault(
     Entry::Level severity, Journal& journal, PhaseFaultType type,
     const std::string& inventoryPath,
-    std::map<std::string, std::string> additionalData)
+    std::map<std::string, std::string> additionalData,
+    const std::vector<uint8_t>& capturedBytes)
 {
     std::string message =
         (type == PhaseFaultType::n)
             ? "xyz.openbmc_project.Power.Regulators.Error.PhaseFault.N"
             : "xyz.openbmc_project.Power.Regulators.Error.PhaseFault.NPlus1";
     additionalData.emplace("CALLOUT_INVENTORY_PATH", inventoryPath);
-    logError(message, severity, additionalData, journal);
+    logError(message, severity, additionalData, journal, capturedBytes);
 }
 
 void DBusErrorLogging::logPMBusError(Entry::Level severity, Journal& journal,
@@ -135,21 +175,7 @@ FFDCFile DBusErrorLogging::createFFDCFile(const std::vector<std::string>& lines)
         }
 
         // Write buffer to file
-        const char* bufPtr = buffer.c_str();
-        unsigned int count = buffer.size();
-        while (count > 0)
-        {
-            // Try to write remaining bytes; it might not write all of them
-            ssize_t bytesWritten = write(fd, bufPtr, count);
-            if (bytesWritten == -1)
-            {
-                throw std::runtime_error{
-                    std::string{"Unable to write to FFDC file: "} +
-                    strerror(errno)};
-            }
-            bufPtr += bytesWritten;
-            count -= bytesWritten;
-        }
+        writeAll(fd, buffer.c_str(), buffer.size());
     }
 
     // Seek to beginning of file so error logging system can read data
@@ -162,10 +188,62 @@ FFDCFile DBusErrorLogging::createFFDCFile(const std::vector<std::string>& lines)
     return file;
 }
 
-std::vector<FFDCFile> DBusErrorLogging::createFFDCFiles(Journal& journal)
+FFDCFile DBusErrorLogging::createBinaryFFDCFile(
+    const std::vector<uint8_t>& capturedBytes)
+{
+    // Create FFDC file of type Custom.  The bytes are written as they are so
+    // large captures don't have to be formatted as text.
+    FFDCFile file{FFDCFormat::Custom, capturedBytesSubType,
+                  capturedBytesVersion};
+    int fd = file.getFileDescriptor();
+    writeAll(fd, reinterpret_cast<const char*>(capturedBytes.data()),
+             capturedBytes.size());
+
+    // Seek to beginning of file so error logging system can read data
+    if (lseek(fd, 0, SEEK_SET) != 0)
+    {
+        throw std::runtime_error{
+            std::string{"Unable to seek within FFDC file: "} + strerror(errno)};
+    }
+
+    return file;
+}
+
+std::vector<FFDCFile> DBusErrorLogging::createFFDCFiles(
+    Journal& journal, const std::vector<uint8_t>& capturedBytes)
 {
     std::vector<FFDCFile> files{};
 
+    // Create FFDC file containing binary device data captured by actions.  This
+    // is first since it is the data most specific to the error.
+    if (!capturedBytes.empty())
+    {
+        try
+        {
+            files.emplace_back(createBinaryFFDCFile(capturedBytes));
+        }
+        catch (const std::exception& e)
+        {
+            journal.logError(exception_utils::getMessages(e));
+        }
+    }
+
+    // Create FFDC file containing the last I2C transactions, which show the
+    // bus activity that led up to the error
+    try
+    {
+        std::vector<std::string> transactions =
+            i2c::I2CTrace::get().format(64);
+        if (!transactions.empty())
+        {
+            files.emplace_back(createFFDCFile(transactions));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        journal.logError(exception_utils::getMessages(e));
+    }
+
     // Create FFDC files containing journal messages from relevant executables.
     // Executables in priority order in case error log cannot hold all the FFDC.
     std::vector<std::string> executables{"phosphor-regulators", "systemd"};
@@ -207,7 +285,8 @@ std::vector<FFDCTuple>
 
 void DBusErrorLogging::logError(
     const std::string& message, Entry::Level severity,
-    std::map<std::string, std::string>& additionalData, Journal& journal)
+    std::map<std::string, std::string>& additionalData, Journal& journal,
+    const std::vector<uint8_t>& capturedBytes)
 {
     try
     {
@@ -215,7 +294,7 @@ void DBusErrorLogging::logError(
         additionalData.emplace("_PID", std::to_string(getpid()));
 
         // Create FFDC files containing debug data to store in error log
-        std::vector<FFDCFile> files{createFFDCFiles(journal)};
+        std::vector<FFDCFile> files{createFFDCFiles(journal, capturedBytes)};
 
         // Create FFDC tuples used to pass FFDC files to D-Bus method
         std::vector<FFDCTuple> ffdcTuples{createFFDCTuples(files)};
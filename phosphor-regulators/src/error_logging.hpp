@@ -109,11 +109,14 @@ class ErrorLogging
      * @param inventoryPath D-Bus inventory path of the device where the error
      *                      occurred
      * @param additionalData additional error data (if any)
+     * @param capturedBytes binary device data captured by actions (if any);
+     *                      stored in the error log as an FFDC file
      */
     virtual void
         logPhaseFault(Entry::Level severity, Journal& journal,
                       PhaseFaultType type, const std::string& inventoryPath,
-                      std::map<std::string, std::string> additionalData) = 0;
+                      std::map<std::string, std::string> additionalData,
+                      const std::vector<uint8_t>& capturedBytes) = 0;
 
     /**
      * Log a PMBus error.
@@ -189,7 +192,8 @@ class DBusErrorLogging : public ErrorLogging
     virtual void logPhaseFault(
         Entry::Level severity, Journal& journal, PhaseFaultType type,
         const std::string& inventoryPath,
-        std::map<std::string, std::string> additionalData) override;
+        std::map<std::string, std::string> additionalData,
+        const std::vector<uint8_t>& capturedBytes) override;
 
     /** @copydoc ErrorLogging::logPMBusError() */
     virtual void logPMBusError(Entry::Level severity, Journal& journal,
@@ -211,6 +215,16 @@ class DBusErrorLogging : public ErrorLogging
      */
     FFDCFile createFFDCFile(const std::vector<std::string>& lines);
 
+    /**
+     * Create an FFDCFile object containing the specified binary device data.
+     *
+     * Throws an exception if an error occurs.
+     *
+     * @param capturedBytes binary device data captured by actions
+     * @return FFDCFile object
+     */
+    FFDCFile createBinaryFFDCFile(const std::vector<uint8_t>& capturedBytes);
+
     /**
      * Create FFDCFile objects containing debug data to store in the error log.
      *
@@ -218,9 +232,12 @@ class DBusErrorLogging : public ErrorLogging
      * is not thrown.
      *
      * @param journal system journal
+     * @param capturedBytes binary device data captured by actions (if any)
      * @return vector of FFDCFile objects
      */
-    std::vector<FFDCFile> createFFDCFiles(Journal& journal);
+    std::vector<FFDCFile>
+        createFFDCFiles(Journal& journal,
+                        const std::vector<uint8_t>& capturedBytes);
 
     /**
      * Create FFDCTuple objects corresponding to the specified FFDC files.
@@ -243,10 +260,12 @@ class DBusErrorLogging : public ErrorLogging
      * @param severity Severity property of the error log entry
      * @param additionalData AdditionalData property of the error log entry
      * @param journal system journal
+     * @param capturedBytes binary device data captured by actions (if any)
      */
     void logError(const std::string& message, Entry::Level severity,
                   std::map<std::string, std::string>& additionalData,
-                  Journal& journal);
+                  Journal& journal,
+                  const std::vector<uint8_t>& capturedBytes = {});
 
     /**
      * Removes the specified FFDC files from the file system.
@@ -14,14 +14,25 @@
  * limitations under the License.
  */
 
+#include "access_stats.hpp"
+#include "i2c_handle_pool.hpp"
+#include "i2c_scheduler.hpp"
+#include "i2c_trace.hpp"
 #include "manager.hpp"
+#include "service_cache.hpp"
 
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <fstream>
 #include <functional>
+#include <ios>
+
+// The file the device access statistics, I2C handle counts, and I2C trace
+// are written to on a USR1 signal
+constexpr auto accessStatsFile = "/tmp/phosphor-regulators-access-stats";
 
 int main(void)
 {
@@ -31,14 +42,35 @@ int main(void)
     auto event = sdeventplus::Event::get_default();
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
 
+    // Look up each D-Bus service once instead of on every access
+    util::ServiceCache::get().enable(bus);
+
+    // Block the signals before the manager starts any threads, so they
+    // inherit the mask and the signals are only handled by the event loop
+    stdplus::signal::block(SIGHUP);
+    stdplus::signal::block(SIGUSR1);
+
     regulators::Manager manager(bus, event);
 
     // Handle HUP signals
-    stdplus::signal::block(SIGHUP);
     sdeventplus::source::Signal signal(
         event, SIGHUP,
         std::bind(&regulators::Manager::sighupHandler, &manager,
                   std::placeholders::_1, std::placeholders::_2));
 
+    // Keep the last I2C transactions for error logs
+    i2c::I2CTrace::get().enable();
+
+    // Write the device access statistics on USR1 signals
+    util::AccessStatsRegistry::get().enable();
+    sdeventplus::source::Signal usr1Signal(
+        event, SIGUSR1, [](auto&, const auto*) {
+            std::ofstream file{accessStatsFile, std::ios::trunc};
+            util::AccessStatsRegistry::get().dump(file);
+            i2c::I2CHandlePool::get().dump(file);
+            i2c::BusScheduler::get().dump(file);
+            i2c::I2CTrace::get().dump(file);
+        });
+
     return event.loop();
 }
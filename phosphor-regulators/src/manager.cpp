@@ -19,6 +19,7 @@
 #include "chassis.hpp"
 #include "config_file_parser.hpp"
 #include "exception_utils.hpp"
+#include "i2c_handle_pool.hpp"
 #include "rule.hpp"
 #include "utility.hpp"
 
@@ -229,6 +230,10 @@ void Manager::monitor(bool enable)
             // while the system is powered off.
             system->closeDevices(services);
         }
+
+        // Close the I2C files the devices left open for reuse, so a
+        // replaced adapter is opened again
+        i2c::I2CHandlePool::get().closeIdle();
     }
 }
 
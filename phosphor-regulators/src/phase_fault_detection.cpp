@@ -25,8 +25,10 @@
 #include "journal.hpp"
 #include "system.hpp"
 
+#include <cstdint>
 #include <exception>
 #include <map>
+#include <vector>
 
 namespace phosphor::power::regulators
 {
@@ -137,8 +139,9 @@ void PhaseFaultDetection::logPhaseFault(PhaseFaultType faultType,
     const std::string& inventoryPath = regulator.getFRU();
     const std::map<std::string, std::string>& additionalData =
         environment.getAdditionalErrorData();
+    const std::vector<uint8_t>& capturedBytes = environment.getCapturedBytes();
     errorLogging.logPhaseFault(severity, journal, faultType, inventoryPath,
-                               additionalData);
+                               additionalData, capturedBytes);
 }
 
 } // namespace phosphor::power::regulators
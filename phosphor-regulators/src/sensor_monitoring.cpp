@@ -22,6 +22,8 @@
 #include "device.hpp"
 #include "error_logging_utils.hpp"
 #include "exception_utils.hpp"
+#include "i2c_interface.hpp"
+#include "i2c_scheduler.hpp"
 #include "rail.hpp"
 #include "sensors.hpp"
 #include "system.hpp"
@@ -40,6 +42,37 @@ namespace phosphor::power::regulators
  */
 constexpr unsigned short maxErrorCount{6};
 
+namespace
+{
+
+/**
+ * Returns whether the specified exception, or one nested within it, is from
+ * an I2C read that was refused because the bus is at its duty cycle limit.
+ *
+ * @param eptr exception pointer
+ * @return true if a read was refused
+ */
+bool isThrottled(std::exception_ptr eptr)
+{
+    for (const std::exception_ptr& exception :
+         exception_utils::getExceptions(eptr))
+    {
+        try
+        {
+            std::rethrow_exception(exception);
+        }
+        catch (const i2c::I2CThrottledException&)
+        {
+            return true;
+        }
+        catch (...)
+        {}
+    }
+    return false;
+}
+
+} // namespace
+
 void SensorMonitoring::execute(Services& services, System& system,
                                Chassis& chassis, Device& device, Rail& rail)
 {
@@ -55,7 +88,9 @@ void SensorMonitoring::execute(Services& services, System& system,
         ActionEnvironment environment{system.getIDMap(), device.getID(),
                                       services};
 
-        // Execute the actions
+        // Execute the actions.  Sensor reads are the ones refused when a bus
+        // reaches its duty cycle limit.
+        i2c::PriorityScope priority{i2c::Priority::Background};
         action_utils::execute(actions, environment);
 
         // Reset consecutive error count since sensors were read successfully
@@ -63,6 +98,14 @@ void SensorMonitoring::execute(Services& services, System& system,
     }
     catch (const std::exception& e)
     {
+        // If a read was refused because the bus is busy, skip the rest of the
+        // sensors until the next monitoring cycle.  This is not an error.
+        if (isThrottled(std::current_exception()))
+        {
+            sensors.skipRail();
+            return;
+        }
+
         // If we haven't hit the maximum consecutive error count yet
         if (errorCount < maxErrorCount)
         {
@@ -148,7 +148,8 @@ inline std::string toString(SensorType type)
  * - startCycle() // At the start of a sensor monitoring cycle
  * - startRail()  // Before reading all the sensors for one rail
  * - setValue()   // To set the value of one sensor for the current rail
- * - endRail()    // After reading all the sensors for one rail
+ * - endRail()    // After reading all the sensors for one rail, or
+ *   skipRail()   // if the rest of them were not read
  * - endCycle()   // At the end of a sensor monitoring cycle
  *
  * This service can be enabled or disabled.  It is typically enabled when the
@@ -211,6 +212,16 @@ class Sensors
      */
     virtual void setValue(SensorType type, double value) = 0;
 
+    /**
+     * Notify the sensors service that the remaining sensors for the current
+     * voltage rail were not read this cycle, for a reason other than an error.
+     * Called instead of endRail().
+     *
+     * The sensors that were not set keep their current state, and are not
+     * removed at the end of the cycle.
+     */
+    virtual void skipRail() = 0;
+
     /**
      * Notify the sensors service that a sensor monitoring cycle is starting.
      */
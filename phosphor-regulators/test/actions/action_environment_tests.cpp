@@ -23,8 +23,10 @@
 #include "rule.hpp"
 
 #include <cstddef> // for size_t
+#include <cstdint>
 #include <exception>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -55,6 +57,7 @@ TEST(ActionEnvironmentTests, Constructor)
     {
         ActionEnvironment env{idMap, "regulator1", services};
         EXPECT_EQ(env.getAdditionalErrorData().size(), 0);
+        EXPECT_EQ(env.getCapturedBytes().size(), 0);
         EXPECT_EQ(env.getDevice().getID(), "regulator1");
         EXPECT_EQ(env.getDeviceID(), "regulator1");
         EXPECT_EQ(env.getPhaseFaults().size(), 0);
@@ -81,6 +84,26 @@ TEST(ActionEnvironmentTests, AddAdditionalErrorData)
     EXPECT_EQ(env.getAdditionalErrorData().at("bar"), "bar_value");
 }
 
+TEST(ActionEnvironmentTests, AddCapturedBytes)
+{
+    IDMap idMap{};
+    MockServices services{};
+    ActionEnvironment env{idMap, "vdd1", services};
+    EXPECT_EQ(env.getCapturedBytes().size(), 0);
+
+    std::vector<uint8_t> bytes{0x12, 0x34, 0x56};
+    env.addCapturedBytes(0x8B, bytes);
+    env.setDeviceID("vio");
+    env.addCapturedBytes(0x20, std::span<const uint8_t>{bytes.data(), 1});
+    std::vector<uint8_t> expected{
+        4, 'v', 'd', 'd', '1', 0x8B, 3, 0x12, 0x34, 0x56, // vdd1 record
+        3, 'v', 'i', 'o', 0x20, 1, 0x12                   // vio record
+    };
+    EXPECT_EQ(env.getCapturedBytes(), expected);
+    EXPECT_GE(env.getCapturedBytes().capacity(),
+              ActionEnvironment::capturedBytesCapacity);
+}
+
 TEST(ActionEnvironmentTests, AddPhaseFault)
 {
     IDMap idMap{};
@@ -138,6 +161,19 @@ TEST(ActionEnvironmentTests, GetAdditionalErrorData)
     EXPECT_EQ(env.getAdditionalErrorData().at("bar"), "bar_value");
 }
 
+TEST(ActionEnvironmentTests, GetCapturedBytes)
+{
+    IDMap idMap{};
+    MockServices services{};
+    ActionEnvironment env{idMap, "", services};
+    EXPECT_EQ(env.getCapturedBytes().size(), 0);
+
+    std::vector<uint8_t> bytes{0xAB};
+    env.addCapturedBytes(0x01, bytes);
+    EXPECT_EQ(env.getCapturedBytes(),
+              (std::vector<uint8_t>{0, 0x01, 1, 0xAB}));
+}
+
 TEST(ActionEnvironmentTests, GetDevice)
 {
     // Create IDMap
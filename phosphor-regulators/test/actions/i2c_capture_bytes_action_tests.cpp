@@ -24,15 +24,19 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 using namespace phosphor::power::regulators;
 
+using ::testing::A;
+using ::testing::Invoke;
 using ::testing::NotNull;
 using ::testing::Return;
 using ::testing::SetArrayArgument;
@@ -47,6 +51,20 @@ TEST(I2CCaptureBytesActionTests, Constructor)
         I2CCaptureBytesAction action{0x2A, 2};
         EXPECT_EQ(action.getRegister(), 0x2A);
         EXPECT_EQ(action.getCount(), 2);
+        EXPECT_EQ(action.isBinary(), false);
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where works: Binary data
+    try
+    {
+        I2CCaptureBytesAction action{0x00, 200, true};
+        EXPECT_EQ(action.getRegister(), 0x00);
+        EXPECT_EQ(action.getCount(), 200);
+        EXPECT_EQ(action.isBinary(), true);
     }
     catch (...)
     {
@@ -139,6 +157,101 @@ TEST(I2CCaptureBytesActionTests, Execute)
         ADD_FAILURE() << "Should not have caught exception.";
     }
 
+    // Test where works: More bytes captured than fit in an SMBus block read
+    try
+    {
+        // Create mock I2CInterface: transfer() writes the register and then
+        // reads 40 bytes with values 0x00 through 0x27
+        std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
+            std::make_unique<i2c::MockedI2CInterface>();
+        EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface,
+                    read(A<uint8_t>(), A<uint8_t&>(), A<uint8_t*>(),
+                         A<i2c::I2CInterface::Mode>()))
+            .Times(0);
+        EXPECT_CALL(*i2cInterface, transfer)
+            .Times(1)
+            .WillOnce(Invoke(
+                [](std::span<const i2c::I2CInterface::Message> messages) {
+                    ASSERT_EQ(messages.size(), 2);
+                    EXPECT_FALSE(messages[0].isRead);
+                    ASSERT_EQ(messages[0].size, 1);
+                    EXPECT_EQ(messages[0].data[0], 0x30);
+                    EXPECT_TRUE(messages[1].isRead);
+                    ASSERT_EQ(messages[1].size, 40);
+                    for (uint8_t i = 0; i < 40; ++i)
+                    {
+                        messages[1].data[i] = i;
+                    }
+                }));
+
+        // Create Device, IDMap, MockServices, and ActionEnvironment
+        Device device{
+            "vdd1", true,
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/vdd1",
+            std::move(i2cInterface)};
+        IDMap idMap{};
+        idMap.addDevice(device);
+        MockServices services{};
+        ActionEnvironment env{idMap, "vdd1", services};
+
+        I2CCaptureBytesAction action{0x30, 40};
+        EXPECT_EQ(action.execute(env), true);
+        EXPECT_EQ(env.getAdditionalErrorData().size(), 1);
+        const std::string& value =
+            env.getAdditionalErrorData().at("vdd1_register_0x30");
+        EXPECT_EQ(value.substr(0, 20), "[ 0x00, 0x01, 0x02, ");
+        EXPECT_EQ(value.substr(value.size() - 14), "0x26, 0x27 ]");
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where works: Binary data captured
+    try
+    {
+        // Create mock I2CInterface: readRange() returns values 0x00 - 0x63
+        std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
+            std::make_unique<i2c::MockedI2CInterface>();
+        EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, readRange(0x40, A<std::span<uint8_t>>()))
+            .Times(1)
+            .WillOnce(Invoke([](uint8_t, std::span<uint8_t> data) {
+                EXPECT_EQ(data.size(), 100);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    data[i] = static_cast<uint8_t>(i);
+                }
+            }));
+
+        // Create Device, IDMap, MockServices, and ActionEnvironment
+        Device device{
+            "vdd1", true,
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/vdd1",
+            std::move(i2cInterface)};
+        IDMap idMap{};
+        idMap.addDevice(device);
+        MockServices services{};
+        ActionEnvironment env{idMap, "vdd1", services};
+
+        // Verify the bytes are stored as binary data, not as strings
+        I2CCaptureBytesAction action{0x40, 100, true};
+        EXPECT_EQ(action.execute(env), true);
+        EXPECT_EQ(env.getAdditionalErrorData().size(), 0);
+        const std::vector<uint8_t>& bytes = env.getCapturedBytes();
+        EXPECT_EQ(bytes.size(), 1 + 4 + 2 + 100);
+        EXPECT_EQ(bytes[0], 4);
+        EXPECT_EQ(bytes[5], 0x40);
+        EXPECT_EQ(bytes[6], 100);
+        EXPECT_EQ(bytes[7], 0x00);
+        EXPECT_EQ(bytes[106], 0x63);
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
     // Test where works: Same device + register captured multiple times
     try
     {
@@ -274,9 +387,19 @@ TEST(I2CCaptureBytesActionTests, GetRegister)
     EXPECT_EQ(action.getRegister(), 0xA0);
 }
 
+TEST(I2CCaptureBytesActionTests, IsBinary)
+{
+    I2CCaptureBytesAction action{0xA0, 3, true};
+    EXPECT_EQ(action.isBinary(), true);
+}
+
 TEST(I2CCaptureBytesActionTests, ToString)
 {
     I2CCaptureBytesAction action{0xA0, 3};
     EXPECT_EQ(action.toString(),
               "i2c_capture_bytes: { register: 0xA0, count: 3 }");
+
+    I2CCaptureBytesAction binaryAction{0x00, 128, true};
+    EXPECT_EQ(binaryAction.toString(),
+              "i2c_capture_bytes: { register: 0x0, count: 128, binary: true }");
 }
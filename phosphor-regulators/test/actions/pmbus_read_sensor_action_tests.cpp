@@ -30,6 +30,7 @@
 #include <exception>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -40,12 +41,37 @@
 using namespace phosphor::power::regulators;
 using namespace phosphor::power::regulators::pmbus_utils;
 
+using ::testing::_;
 using ::testing::A;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 using ::testing::Throw;
 using ::testing::TypedEq;
 
+/**
+ * Returns a mock action for I2CInterface::transfer() that checks it reads
+ * VOUT_MODE and then the specified command, and returns the specified values.
+ */
+auto transferVoutMode(uint8_t command, uint8_t voutMode, uint16_t value)
+{
+    return Invoke(
+        [=](std::span<const i2c::I2CInterface::Message> messages) {
+            ASSERT_EQ(messages.size(), 4);
+            EXPECT_FALSE(messages[0].isRead);
+            EXPECT_EQ(messages[0].data[0], 0x20);
+            EXPECT_TRUE(messages[1].isRead);
+            ASSERT_EQ(messages[1].size, 1);
+            messages[1].data[0] = voutMode;
+            EXPECT_FALSE(messages[2].isRead);
+            EXPECT_EQ(messages[2].data[0], command);
+            EXPECT_TRUE(messages[3].isRead);
+            ASSERT_EQ(messages[3].size, 2);
+            messages[3].data[0] = value & 0xFF;
+            messages[3].data[1] = value >> 8;
+        });
+}
+
 TEST(PMBusReadSensorActionTests, Constructor)
 {
     // Test where works: exponent value is specified
@@ -182,18 +208,70 @@ TEST(PMBusReadSensorActionTests, Execute)
         // * Decimal value: 816 * 2^(-8) = 3.1875
 
         // Create mock I2CInterface.  Expect action to do the following:
-        // * will read 0x0330 from READ_VOUT (command/register 0x8B)
+        // * will read 0b0001'1000 (linear format, -8 exponent) from VOUT_MODE
+        //   (command/register 0x20) and 0x0330 from READ_VOUT
+        //   (command/register 0x8B) in one transfer
+        std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
+            std::make_unique<i2c::MockedI2CInterface>();
+        EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, canTransfer)
+            .Times(1)
+            .WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, transfer(_))
+            .Times(1)
+            .WillOnce(transferVoutMode(0x8B, 0b0001'1000, 0x0330));
+        EXPECT_CALL(*i2cInterface, read(A<uint8_t>(), A<uint16_t&>()))
+            .Times(0);
+
+        // Create MockServices.  Expect the sensor value to be set.
+        MockServices services{};
+        MockSensors& sensors = services.getMockSensors();
+        EXPECT_CALL(sensors, setValue(SensorType::vout, 3.1875)).Times(1);
+
+        // Create Device, IDMap, and ActionEnvironment
+        Device device{
+            "reg1", true,
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/reg1",
+            std::move(i2cInterface)};
+        IDMap idMap{};
+        idMap.addDevice(device);
+        ActionEnvironment env{idMap, "reg1", services};
+
+        // Create and execute action
+        SensorType type{SensorType::vout};
+        uint8_t command{0x8B};
+        SensorDataFormat format{SensorDataFormat::linear_16};
+        std::optional<int8_t> exponent{};
+        PMBusReadSensorAction action{type, command, format, exponent};
+        EXPECT_EQ(action.execute(env), true);
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where works: linear_16 format: exponent not specified in
+    // constructor: interface can't do a combined transaction, such as when
+    // PEC is enabled
+    try
+    {
+        // Create mock I2CInterface.  Expect action to do the following:
         // * will read 0b0001'1000 (linear format, -8 exponent) from VOUT_MODE
         //   (command/register 0x20)
+        // * will read 0x0330 from READ_VOUT (command/register 0x8B)
         std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
             std::make_unique<i2c::MockedI2CInterface>();
         EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
-        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x8B), A<uint16_t&>()))
+        EXPECT_CALL(*i2cInterface, canTransfer)
             .Times(1)
-            .WillOnce(SetArgReferee<1>(0x0330));
+            .WillOnce(Return(false));
+        EXPECT_CALL(*i2cInterface, transfer(_)).Times(0);
         EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x20), A<uint8_t&>()))
             .Times(1)
             .WillOnce(SetArgReferee<1>(0b0001'1000));
+        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x8B), A<uint16_t&>()))
+            .Times(1)
+            .WillOnce(SetArgReferee<1>(0x0330));
 
         // Create MockServices.  Expect the sensor value to be set.
         MockServices services{};
@@ -252,16 +330,17 @@ TEST(PMBusReadSensorActionTests, Execute)
     try
     {
         // Create mock I2CInterface.  Expect action to do the following:
-        // * will read READ_VOUT (command/register 0x8B)
-        // * will read 0b0010'0000 (VID data format) from VOUT_MODE
+        // * will read 0b0010'0000 (VID data format) from VOUT_MODE and
+        //   READ_VOUT (command/register 0x8B) in one transfer
         std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
             std::make_unique<i2c::MockedI2CInterface>();
         EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
-        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x8B), A<uint16_t&>()))
-            .Times(1);
-        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x20), A<uint8_t&>()))
+        EXPECT_CALL(*i2cInterface, canTransfer)
             .Times(1)
-            .WillOnce(SetArgReferee<1>(0b0010'0000));
+            .WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, transfer(_))
+            .Times(1)
+            .WillOnce(transferVoutMode(0x8B, 0b0010'0000, 0x0000));
 
         // Create Device, IDMap, MockServices, and ActionEnvironment
         Device device{
@@ -315,17 +394,18 @@ TEST(PMBusReadSensorActionTests, Execute)
     try
     {
         // Create mock I2CInterface.  Expect action to do the following:
-        // * will read command/register 0xC6
-        // * will try to read VOUT_MODE; exception will be thrown
+        // * will try to read VOUT_MODE and command/register 0xC6 in one
+        //   transfer; exception will be thrown
         std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
             std::make_unique<i2c::MockedI2CInterface>();
         EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
-        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0xC6), A<uint16_t&>()))
-            .Times(1);
-        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x20), A<uint8_t&>()))
+        EXPECT_CALL(*i2cInterface, canTransfer)
+            .Times(1)
+            .WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, transfer(_))
             .Times(1)
             .WillOnce(Throw(
-                i2c::I2CException{"Failed to read byte", "/dev/i2c-1", 0x70}));
+                i2c::I2CException{"Failed to transfer", "/dev/i2c-1", 0x70}));
 
         // Create Device, IDMap, MockServices, and ActionEnvironment
         Device device{
@@ -361,7 +441,7 @@ TEST(PMBusReadSensorActionTests, Execute)
         {
             EXPECT_STREQ(
                 ie.what(),
-                "I2CException: Failed to read byte: bus /dev/i2c-1, addr 0x70");
+                "I2CException: Failed to transfer: bus /dev/i2c-1, addr 0x70");
         }
         catch (...)
         {
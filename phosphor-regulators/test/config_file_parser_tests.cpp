@@ -2123,6 +2123,23 @@ TEST(ConfigFileParserTests, ParseI2CCaptureBytes)
             parseI2CCaptureBytes(element);
         EXPECT_EQ(action->getRegister(), 0xA0);
         EXPECT_EQ(action->getCount(), 2);
+        EXPECT_FALSE(action->isBinary());
+    }
+
+    // Test where works: binary specified
+    {
+        const json element = R"(
+            {
+              "register": "0x00",
+              "count": 128,
+              "binary": true
+            }
+        )"_json;
+        std::unique_ptr<I2CCaptureBytesAction> action =
+            parseI2CCaptureBytes(element);
+        EXPECT_EQ(action->getRegister(), 0x00);
+        EXPECT_EQ(action->getCount(), 128);
+        EXPECT_TRUE(action->isBinary());
     }
 
     // Test where fails: Element is not an object
@@ -2171,6 +2188,24 @@ TEST(ConfigFileParserTests, ParseI2CCaptureBytes)
         EXPECT_STREQ(e.what(), "Invalid byte count: Must be > 0");
     }
 
+    // Test where fails: binary value is invalid
+    try
+    {
+        const json element = R"(
+            {
+              "register": "0xA0",
+              "count": 2,
+              "binary": 1
+            }
+        )"_json;
+        parseI2CCaptureBytes(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element is not a boolean");
+    }
+
     // Test where fails: Required register property not specified
     try
     {
@@ -2707,6 +2742,178 @@ TEST(ConfigFileParserTests, ParseI2CCompareBytes)
     }
 }
 
+TEST(ConfigFileParserTests, ParseI2CInterface)
+{
+    // Test where works: Only required properties specified
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 1,
+              "address": "0x70"
+            }
+        )"_json;
+        std::unique_ptr<i2c::I2CInterface> interface =
+            parseI2CInterface(element);
+        EXPECT_NE(interface.get(), nullptr);
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where works: pec specified
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 1,
+              "address": "0x70",
+              "pec": true
+            }
+        )"_json;
+        std::unique_ptr<i2c::I2CInterface> interface =
+            parseI2CInterface(element);
+        EXPECT_NE(interface.get(), nullptr);
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where works: bus_clock_rate and bus_duty_cycle_limit specified
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 9,
+              "address": "0x70",
+              "bus_clock_rate": 400000,
+              "bus_duty_cycle_limit": 0.5
+            }
+        )"_json;
+        std::unique_ptr<i2c::I2CInterface> interface =
+            parseI2CInterface(element);
+        EXPECT_NE(interface.get(), nullptr);
+    }
+    catch (const std::exception& e)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where fails: pec value is invalid
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 1,
+              "address": "0x70",
+              "pec": 1
+            }
+        )"_json;
+        parseI2CInterface(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element is not a boolean");
+    }
+
+    // Test where fails: bus_clock_rate value is invalid
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 9,
+              "address": "0x70",
+              "bus_clock_rate": -1
+            }
+        )"_json;
+        parseI2CInterface(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element is not an unsigned integer");
+    }
+
+    // Test where fails: bus_clock_rate value is 0
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 9,
+              "address": "0x70",
+              "bus_clock_rate": 0
+            }
+        )"_json;
+        parseI2CInterface(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Invalid bus clock rate: Must be > 0");
+    }
+
+    // Test where fails: bus_duty_cycle_limit value is invalid
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 9,
+              "address": "0x70",
+              "bus_duty_cycle_limit": "0.5"
+            }
+        )"_json;
+        parseI2CInterface(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element is not a number");
+    }
+
+    // Test where fails: bus_duty_cycle_limit value is out of range
+    for (double limit : {0.0, 1.5})
+    {
+        try
+        {
+            json element = R"(
+                {
+                  "bus": 9,
+                  "address": "0x70"
+                }
+            )"_json;
+            element["bus_duty_cycle_limit"] = limit;
+            parseI2CInterface(element);
+            ADD_FAILURE() << "Should not have reached this line.";
+        }
+        catch (const std::invalid_argument& e)
+        {
+            EXPECT_STREQ(e.what(),
+                         "Invalid bus duty cycle limit: Must be > 0 and <= 1");
+        }
+    }
+
+    // Test where fails: Invalid property specified
+    try
+    {
+        const json element = R"(
+            {
+              "bus": 1,
+              "address": "0x70",
+              "foo": true
+            }
+        )"_json;
+        parseI2CInterface(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element contains an invalid property");
+    }
+}
+
 TEST(ConfigFileParserTests, ParseI2CWriteBit)
 {
     // Test where works
@@ -56,7 +56,8 @@ class MockErrorLogging : public ErrorLogging
     MOCK_METHOD(void, logPhaseFault,
                 (Entry::Level severity, Journal& journal, PhaseFaultType type,
                  const std::string& inventoryPath,
-                 (std::map<std::string, std::string> additionalData)),
+                 (std::map<std::string, std::string> additionalData),
+                 const std::vector<uint8_t>& capturedBytes),
                 (override));
 
     MOCK_METHOD(void, logPMBusError,
@@ -50,6 +50,8 @@ class MockSensors : public Sensors
 
     MOCK_METHOD(void, setValue, (SensorType type, double value), (override));
 
+    MOCK_METHOD(void, skipRail, (), (override));
+
     MOCK_METHOD(void, startCycle, (), (override));
 
     MOCK_METHOD(void, startRail,
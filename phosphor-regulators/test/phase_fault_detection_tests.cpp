@@ -35,6 +35,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -47,6 +48,8 @@ using namespace phosphor::power::regulators;
 
 using ::testing::_;
 using ::testing::A;
+using ::testing::Invoke;
+using ::testing::IsEmpty;
 using ::testing::NotNull;
 using ::testing::Ref;
 using ::testing::Return;
@@ -235,10 +238,11 @@ TEST_F(PhaseFaultDetectionTests, ClearErrorHistory)
         // - N+1 phase fault error should be logged once
         MockErrorLogging& errorLogging = services.getMockErrorLogging();
         EXPECT_CALL(errorLogging, logInternalError).Times(1);
-        EXPECT_CALL(errorLogging, logPhaseFault(_, _, PhaseFaultType::n, _, _))
+        EXPECT_CALL(errorLogging,
+                    logPhaseFault(_, _, PhaseFaultType::n, _, _, _))
             .Times(1);
         EXPECT_CALL(errorLogging,
-                    logPhaseFault(_, _, PhaseFaultType::n_plus_1, _, _))
+                    logPhaseFault(_, _, PhaseFaultType::n_plus_1, _, _, _))
             .Times(1);
     };
 
@@ -502,10 +506,10 @@ TEST_F(PhaseFaultDetectionTests, Execute)
         EXPECT_CALL(errorLogging,
                     logPhaseFault(Entry::Level::Warning, Ref(journal),
                                   PhaseFaultType::n, regulator->getFRU(),
-                                  additionalData))
+                                  additionalData, IsEmpty()))
             .Times(1);
         EXPECT_CALL(errorLogging,
-                    logPhaseFault(_, _, PhaseFaultType::n_plus_1, _, _))
+                    logPhaseFault(_, _, PhaseFaultType::n_plus_1, _, _, _))
             .Times(0);
 
         // Execute PhaseFaultDetection 5 times
@@ -550,9 +554,10 @@ TEST_F(PhaseFaultDetectionTests, Execute)
         EXPECT_CALL(errorLogging,
                     logPhaseFault(Entry::Level::Informational, Ref(journal),
                                   PhaseFaultType::n_plus_1, regulator->getFRU(),
-                                  additionalData))
+                                  additionalData, IsEmpty()))
             .Times(1);
-        EXPECT_CALL(errorLogging, logPhaseFault(_, _, PhaseFaultType::n, _, _))
+        EXPECT_CALL(errorLogging,
+                    logPhaseFault(_, _, PhaseFaultType::n, _, _, _))
             .Times(0);
 
         // Execute PhaseFaultDetection 5 times
@@ -605,12 +610,12 @@ TEST_F(PhaseFaultDetectionTests, Execute)
         EXPECT_CALL(errorLogging,
                     logPhaseFault(Entry::Level::Informational, Ref(journal),
                                   PhaseFaultType::n_plus_1, regulator->getFRU(),
-                                  additionalData))
+                                  additionalData, IsEmpty()))
             .Times(1);
         EXPECT_CALL(errorLogging,
                     logPhaseFault(Entry::Level::Warning, Ref(journal),
                                   PhaseFaultType::n, regulator->getFRU(),
-                                  additionalData))
+                                  additionalData, IsEmpty()))
             .Times(1);
 
         // Execute PhaseFaultDetection 5 times
@@ -670,7 +675,57 @@ TEST_F(PhaseFaultDetectionTests, Execute)
         EXPECT_CALL(errorLogging,
                     logPhaseFault(Entry::Level::Warning, Ref(journal),
                                   PhaseFaultType::n, regulator->getFRU(),
-                                  additionalData))
+                                  additionalData, IsEmpty()))
+            .Times(1);
+
+        // Execute PhaseFaultDetection 5 times
+        for (int i = 1; i <= 5; ++i)
+        {
+            detection.execute(services, *system, *chassis, *regulator);
+        }
+    }
+
+    // Test where binary device data is captured
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+
+        // Create action that will capture 2 bytes from registers 0x10 and 0x11
+        // as binary data
+        actions.push_back(
+            std::make_unique<I2CCaptureBytesAction>(0x10, 2, true));
+
+        // Create action that will log an N phase fault in ActionEnvironment
+        actions.push_back(
+            std::make_unique<LogPhaseFaultAction>(PhaseFaultType::n));
+
+        // Create PhaseFaultDetection
+        PhaseFaultDetection detection{std::move(actions)};
+
+        // Set expectations for regulator I2C interface:
+        // - isOpen() will return true
+        // - reading registers 0x10 and 0x11 will return [ 0xAB, 0xCD ]
+        EXPECT_CALL(*regI2CInterface, isOpen).WillRepeatedly(Return(true));
+        EXPECT_CALL(*regI2CInterface, readRange(0x10, _))
+            .Times(5)
+            .WillRepeatedly(Invoke([](uint8_t, std::span<uint8_t> data) {
+                data[0] = 0xAB;
+                data[1] = 0xCD;
+            }));
+
+        // Create mock services with the following expectations:
+        // - 2 error messages in journal for N phase fault detected
+        // - 1 N phase fault error logged with the binary data for device vdd1
+        MockServices services{};
+        MockJournal& journal = services.getMockJournal();
+        EXPECT_CALL(journal, logError(A<const std::string&>())).Times(2);
+        MockErrorLogging& errorLogging = services.getMockErrorLogging();
+        std::map<std::string, std::string> additionalData{};
+        std::vector<uint8_t> capturedBytes{4,    'v',  'd',  'd', '1',
+                                           0x10, 0x02, 0xAB, 0xCD};
+        EXPECT_CALL(errorLogging,
+                    logPhaseFault(Entry::Level::Warning, Ref(journal),
+                                  PhaseFaultType::n, regulator->getFRU(),
+                                  additionalData, capturedBytes))
             .Times(1);
 
         // Execute PhaseFaultDetection 5 times
@@ -1215,6 +1215,14 @@ TEST(ValidateRegulatorsConfigTest, I2CCaptureBytes)
         EXPECT_JSON_VALID(configFile);
     }
 
+    // Valid: binary specified
+    {
+        json configFile = initialFile;
+        configFile["rules"][0]["actions"][1]["i2c_capture_bytes"]["binary"] =
+            true;
+        EXPECT_JSON_VALID(configFile);
+    }
+
     // Invalid: register not specified
     {
         json configFile = initialFile;
@@ -1276,6 +1284,15 @@ TEST(ValidateRegulatorsConfigTest, I2CCaptureBytes)
         EXPECT_JSON_INVALID(configFile, "Validation failed.",
                             "0 is less than the minimum of 1");
     }
+
+    // Invalid: binary has wrong data type
+    {
+        json configFile = initialFile;
+        configFile["rules"][0]["actions"][1]["i2c_capture_bytes"]["binary"] =
+            1;
+        EXPECT_JSON_INVALID(configFile, "Validation failed.",
+                            "1 is not of type 'boolean'");
+    }
 }
 
 TEST(ValidateRegulatorsConfigTest, I2CCompareBit)
@@ -1767,6 +1784,46 @@ TEST(ValidateRegulatorsConfigTest, I2CInterface)
         EXPECT_JSON_INVALID(configFile, "Validation failed.",
                             "'0x700' does not match '^0x[0-9A-Fa-f]{2}$'");
     }
+    // Valid: test i2c_interface with bus_clock_rate and
+    // bus_duty_cycle_limit.
+    {
+        json configFile = validConfigFile;
+        json& i2cInterface =
+            configFile["chassis"][0]["devices"][0]["i2c_interface"];
+        i2cInterface["bus_clock_rate"] = 400000;
+        i2cInterface["bus_duty_cycle_limit"] = 0.5;
+        EXPECT_JSON_VALID(configFile);
+    }
+    // Invalid: test i2c_interface with property bus_clock_rate less than
+    // 1.
+    {
+        json configFile = validConfigFile;
+        json& i2cInterface =
+            configFile["chassis"][0]["devices"][0]["i2c_interface"];
+        i2cInterface["bus_clock_rate"] = 0;
+        EXPECT_JSON_INVALID(configFile, "Validation failed.",
+                            "0 is less than the minimum of 1");
+    }
+    // Invalid: test i2c_interface with property bus_duty_cycle_limit
+    // greater than 1.
+    {
+        json configFile = validConfigFile;
+        json& i2cInterface =
+            configFile["chassis"][0]["devices"][0]["i2c_interface"];
+        i2cInterface["bus_duty_cycle_limit"] = 1.5;
+        EXPECT_JSON_INVALID(configFile, "Validation failed.",
+                            "1.5 is greater than the maximum of 1");
+    }
+    // Invalid: test i2c_interface with property bus_duty_cycle_limit
+    // equal to 0.
+    {
+        json configFile = validConfigFile;
+        json& i2cInterface =
+            configFile["chassis"][0]["devices"][0]["i2c_interface"];
+        i2cInterface["bus_duty_cycle_limit"] = 0;
+        EXPECT_JSON_INVALID(configFile, "Validation failed.",
+                            "0 is less than or equal to the minimum of 0");
+    }
 }
 
 TEST(ValidateRegulatorsConfigTest, I2CWriteBit)
@@ -15,11 +15,21 @@
  */
 #include "pmbus.hpp"
 
+#include "access_stats.hpp"
+#include "hwmon_resolver.hpp"
+
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/elog.hpp>
 #include <xyz/openbmc_project/Common/Device/error.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
 
@@ -33,6 +43,19 @@ using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 using namespace sdbusplus::xyz::openbmc_project::Common::Device::Error;
 namespace fs = std::filesystem;
 
+/**
+ * @brief Returns the first whitespace delimited word in the buffer.
+ *
+ * This matches what extracting a std::string from a stream would return.
+ */
+static std::string_view firstWord(const char* buffer, size_t size)
+{
+    auto isSpace = [](unsigned char c) { return std::isspace(c); };
+    auto begin = std::find_if_not(buffer, buffer + size, isSpace);
+    auto end = std::find_if(begin, buffer + size, isSpace);
+    return std::string_view(begin, end - begin);
+}
+
 /**
  * @brief Helper to close a file handle
  */
@@ -58,31 +81,92 @@ std::string PMBus::insertPageNum(const std::string& templateName, size_t page)
     return name;
 }
 
-fs::path PMBus::getPath(Type type)
+const fs::path& PMBus::getPath(Type type)
 {
+    auto& path = typePaths[static_cast<size_t>(type)];
+    if (path)
+    {
+        return *path;
+    }
+
+    auto usesHwmonDir = (type == Type::Hwmon) || (type == Type::Debug) ||
+                        (type == Type::HwmonDeviceDebug);
+    if (usesHwmonDir && hwmonDir.empty())
+    {
+        // The device driver may not have created the hwmon directory yet
+        // when it was last looked for, so look for it again now.
+        hwmonDir = HwmonResolver::get().find(basePath);
+        if (hwmonDir.empty())
+        {
+            // Don't hold on to a path without the directory in it, so it
+            // is looked for again on the next access.
+            uncachedPath = (type == Type::Hwmon) ? basePath / "hwmon"
+                                                 : debugPath / "pmbus";
+            return uncachedPath;
+        }
+    }
+
     switch (type)
     {
         default:
         /* fall through */
         case Type::Base:
-            return basePath;
+            path = basePath;
             break;
         case Type::Hwmon:
-            return basePath / "hwmon" / hwmonDir;
+            path = basePath / "hwmon" / hwmonDir;
             break;
         case Type::Debug:
-            return debugPath / "pmbus" / hwmonDir;
+            path = debugPath / "pmbus" / hwmonDir;
             break;
         case Type::DeviceDebug:
         {
             auto dir = driverName + "." + std::to_string(instance);
-            return debugPath / dir;
+            path = debugPath / dir;
             break;
         }
         case Type::HwmonDeviceDebug:
-            return debugPath / "pmbus" / hwmonDir / getDeviceName();
+        {
+            auto name = getDeviceName();
+            if (name.empty())
+            {
+                // Don't hold on to a path without the device name in it,
+                // the device may just not be there yet.
+                path.reset();
+                uncachedPath = debugPath / "pmbus" / hwmonDir;
+                return uncachedPath;
+            }
+            path = debugPath / "pmbus" / hwmonDir / name;
             break;
+        }
+    }
+
+    return *path;
+}
+
+const fs::path& PMBus::getPagedPath(PagedAttribute attribute, size_t page,
+                                    Type type)
+{
+    auto& paths = pagedPaths[static_cast<size_t>(type)]
+                            [static_cast<size_t>(attribute)];
+    if (paths.empty())
+    {
+        const auto& dir = getPath(type);
+        if (!typePaths[static_cast<size_t>(type)])
+        {
+            // The directory isn't known yet, so don't save anything
+            uncachedPath = dir / getPagedName(attribute, page);
+            return uncachedPath;
+        }
+
+        paths.reserve(MAX_PAGES);
+        for (size_t p = 0; p < MAX_PAGES; p++)
+        {
+            paths.push_back(dir / getPagedName(attribute, p));
+        }
     }
+
+    return paths.at(page);
 }
 
 std::string PMBus::getDeviceName()
@@ -118,43 +202,36 @@ bool PMBus::readBitInPage(const std::string& name, size_t page, Type type)
 bool PMBus::readBit(const std::string& name, Type type)
 {
     unsigned long int value = 0;
-    std::ifstream file;
-    fs::path path = getPath(type);
-
-    path /= name;
+    const auto& dir = getPath(type);
 
-    file.exceptions(std::ifstream::failbit | std::ifstream::badbit |
-                    std::ifstream::eofbit);
+    char val[2] = {'\0', '\0'};
+    auto bytes = readFile(dir, name, val, 1);
+    auto rc = errno;
 
-    try
+    if (bytes == 1)
     {
-        char* err = NULL;
-        std::string val{1, '\0'};
-
-        file.open(path);
-        file.read(&val[0], 1);
+        auto [ptr, ec] = std::from_chars(val, val + 1, value, 10);
 
-        value = strtoul(val.c_str(), &err, 10);
-
-        if (*err)
+        if ((ec != std::errc{}) || (ptr != val + 1))
         {
             log<level::ERR>((std::string("Invalid character in sysfs file"
                                          " FILE=") +
-                             path.string() + std::string(" CONTENTS=") + val)
+                             (dir / name).string() +
+                             std::string(" CONTENTS=") + val)
                                 .c_str());
 
-            // Catch below and handle as a read failure
-            elog<InternalFailure>();
+            // Handle below as a read failure
+            bytes = -1;
+            rc = EINVAL;
         }
     }
-    catch (const std::exception& e)
-    {
-        auto rc = errno;
 
+    if (bytes != 1)
+    {
         log<level::ERR>((std::string("Failed to read sysfs file "
                                      "errno=") +
                          std::to_string(rc) + std::string(" FILENAME=") +
-                         path.string())
+                         (dir / name).string())
                             .c_str());
 
         using metadata = xyz::openbmc_project::Common::Device::ReadFailure;
@@ -176,28 +253,72 @@ bool PMBus::exists(const std::string& name, Type type)
 
 uint64_t PMBus::read(const std::string& name, Type type, bool errTrace)
 {
-    uint64_t data = 0;
-    std::ifstream file;
-    auto path = getPath(type);
-    path /= name;
+    return readValue(getPath(type), name, errTrace);
+}
 
-    file.exceptions(std::ifstream::failbit | std::ifstream::badbit |
-                    std::ifstream::eofbit);
+bool PMBus::exists(PagedAttribute attribute, size_t page, Type type)
+{
+    return fs::exists(getPagedPath(attribute, page, type));
+}
 
-    try
+uint64_t PMBus::read(PagedAttribute attribute, size_t page, Type type,
+                     bool errTrace)
+{
+    return readValue(getPath(type), getPagedName(attribute, page), errTrace);
+}
+
+void PMBus::readMany(std::span<const Attribute> attributes,
+                     std::span<uint64_t> values)
+{
+    if (attributes.size() != values.size())
     {
-        file.open(path);
-        file >> std::hex >> data;
+        throw std::invalid_argument{"Attribute and value count mismatch"};
     }
-    catch (const std::exception& e)
+
+    for (size_t i = 0; i < attributes.size(); ++i)
     {
-        auto rc = errno;
+        values[i] =
+            readValue(getPath(attributes[i].type), attributes[i].name, true);
+    }
+}
+
+uint64_t PMBus::readValue(const fs::path& dir, std::string_view name,
+                          bool errTrace)
+{
+    uint64_t data = 0;
+
+    char buffer[maxFileSize];
+    auto bytes = readFile(dir, name, buffer, sizeof(buffer));
+    auto rc = errno;
+
+    if (bytes > 0)
+    {
+        // The value is in hex, with an optional 0x prefix
+        auto word = firstWord(buffer, bytes);
+        if ((word.size() > 2) && (word[0] == '0') &&
+            ((word[1] == 'x') || (word[1] == 'X')))
+        {
+            word.remove_prefix(2);
+        }
+
+        auto [ptr, ec] =
+            std::from_chars(word.data(), word.data() + word.size(), data, 16);
+        if ((ec != std::errc{}) || (ptr == word.data()))
+        {
+            // Handle below as a read failure
+            bytes = -1;
+            rc = EINVAL;
+        }
+    }
 
+    if (bytes <= 0)
+    {
         if (errTrace)
         {
             log<level::ERR>((std::string("Failed to read sysfs file "
                                          "errno=") +
-                             std::to_string(rc) + " FILENAME=" + path.string())
+                             std::to_string(rc) + " FILENAME=" +
+                             (dir / name).string())
                                 .c_str());
 
             using metadata = xyz::openbmc_project::Common::Device::ReadFailure;
@@ -217,25 +338,34 @@ uint64_t PMBus::read(const std::string& name, Type type, bool errTrace)
 
 std::string PMBus::readString(const std::string& name, Type type)
 {
-    std::string data;
-    std::ifstream file;
-    auto path = getPath(type);
-    path /= name;
+    return std::string{readStringView(name, type)};
+}
 
-    file.exceptions(std::ifstream::failbit | std::ifstream::badbit |
-                    std::ifstream::eofbit);
+std::string_view PMBus::readStringView(const std::string& name, Type type)
+{
+    std::string_view data;
+    const auto& dir = getPath(type);
 
-    try
+    auto bytes = readFile(dir, name, stringBuffer.data(), stringBuffer.size());
+    auto rc = errno;
+
+    if (bytes > 0)
     {
-        file.open(path);
-        file >> data;
+        // Only the first whitespace delimited word in the file is returned
+        data = firstWord(stringBuffer.data(), bytes);
     }
-    catch (const std::exception& e)
+
+    if (data.empty())
     {
-        auto rc = errno;
+        if (bytes >= 0)
+        {
+            rc = ENODATA;
+        }
+
         log<level::ERR>((std::string("Failed to read sysfs file "
                                      "errno=") +
-                         std::to_string(rc) + " FILENAME=" + path.string())
+                         std::to_string(rc) + " FILENAME=" +
+                         (dir / name).string())
                             .c_str());
 
         using metadata = xyz::openbmc_project::Common::Device::ReadFailure;
@@ -248,6 +378,27 @@ std::string PMBus::readString(const std::string& name, Type type)
     return data;
 }
 
+phosphor::power::util::FileDescriptor
+    PMBus::openPollable(const std::string& name, Type type)
+{
+    auto path = getPath(type);
+    path /= name;
+
+    phosphor::power::util::FileDescriptor fd{
+        ::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd)
+    {
+        // poll() only reports changes since the file was last read
+        char buffer[maxFileSize];
+        if (pread(fd(), buffer, sizeof(buffer), 0) == -1)
+        {
+            fd.close();
+        }
+    }
+
+    return fd;
+}
+
 std::vector<uint8_t> PMBus::readBinary(const std::string& name, Type type,
                                        size_t length)
 {
@@ -362,29 +513,68 @@ void PMBus::writeBinary(const std::string& name, std::vector<uint8_t> data,
     }
 }
 
-void PMBus::findHwmonDir()
+ssize_t PMBus::readFile(const fs::path& dir, std::string_view name,
+                        char* buffer, size_t size)
 {
-    fs::path path{basePath};
-    path /= "hwmon";
+    phosphor::power::util::AccessTimer timer{dir.native(), name};
 
-    // Make sure the directory exists, otherwise for things that can be
-    // dynamically present or not present an exception will be thrown if the
-    // hwmon directory is not there, resulting in a program termination.
-    if (fs::is_directory(path))
+    // Only a file that isn't open yet needs its full path built
+    auto dirIt = fileDescriptors.find(dir.native());
+    if (dirIt == fileDescriptors.end())
     {
-        // look for <basePath>/hwmon/hwmonN/
-        for (auto& f : fs::directory_iterator(path))
+        dirIt = fileDescriptors.emplace(dir.native(), FileDescriptors{}).first;
+    }
+
+    auto& files = dirIt->second;
+    auto it = files.find(name);
+    if (it == files.end())
+    {
+        auto path = dir / name;
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
         {
-            if ((f.path().filename().string().find("hwmon") !=
-                 std::string::npos) &&
-                (fs::is_directory(f.path())))
-            {
-                hwmonDir = f.path().filename();
-                break;
-            }
+            timer.setFailed();
+            return -1;
         }
+
+        it = files.emplace(std::string{name}, fd).first;
+    }
+
+    // sysfs regenerates the file contents on each read from offset 0
+    auto bytes = pread(it->second(), buffer, size, 0);
+    if (bytes == -1)
+    {
+        timer.setFailed();
+    }
+    if ((bytes == -1) && (errno != EAGAIN) && (errno != EINTR))
+    {
+        // The descriptor may be stale, such as after the device driver was
+        // unbound and bound again, when reads fail with ENODEV, ENXIO or
+        // EIO.  Drop it so the next access will open the file again.
+        auto rc = errno;
+        files.erase(it);
+        errno = rc;
     }
 
+    return bytes;
+}
+
+void PMBus::findHwmonDir()
+{
+    setHwmonDir(HwmonResolver::get().find(basePath));
+}
+
+void PMBus::setHwmonDir(const fs::path& dir)
+{
+    // The hwmon directory may change if the device driver was rebound, so
+    // do not hold on to descriptors or paths for files that may no longer
+    // exist.
+    fileDescriptors.clear();
+    typePaths = {};
+    pagedPaths = {};
+
+    hwmonDir = dir;
+
     // Don't really want to crash here, just log it
     // and let accesses fail later
     if (hwmonDir.empty())
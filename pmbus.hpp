@@ -1,7 +1,17 @@
 #pragma once
 
+#include "file_descriptor.hpp"
+
+#include <sys/types.h>
+
+#include <array>
 #include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace phosphor
@@ -160,6 +170,151 @@ enum class Type
     HwmonDeviceDebug // hwmon device debug directory
 };
 
+/**
+ * An attribute to read with PMBusBase::readMany()
+ *
+ * Lists of attributes are meant to be built once and reused, so that
+ * reading them doesn't need to build any names.
+ */
+struct Attribute
+{
+    /** The file name, relative to the directory for the type */
+    std::string name;
+
+    /** The path type */
+    Type type = Type::Base;
+};
+
+/**
+ * The number of pages that paged attribute names are generated for
+ */
+constexpr size_t MAX_PAGES = 32;
+
+/**
+ * @class PagedName
+ *
+ * A PMBus attribute name with the page number filled in.  This is built
+ * at compile time from a template name, like STATUS_VOUT, so that paged
+ * accesses don't need to build the name at runtime.
+ */
+class PagedName
+{
+  public:
+    /**
+     * The longest attribute name supported
+     */
+    static constexpr size_t maxLength = 31;
+
+    constexpr PagedName() = default;
+
+    /**
+     * Constructor
+     *
+     * Replaces the 'P' in the template name with the page number,
+     * the same way PMBus::insertPageNum() does.
+     *
+     * @param[in] templateName - the name string, with a 'P' in it
+     * @param[in] page - the page number to insert where the P was
+     */
+    constexpr PagedName(std::string_view templateName, size_t page)
+    {
+        auto pos = templateName.find('P');
+        append(templateName.substr(0, pos));
+
+        if (pos != std::string_view::npos)
+        {
+            char digits[20]{};
+            size_t count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + page % 10);
+                page /= 10;
+            } while (page != 0);
+
+            while (count > 0)
+            {
+                append(std::string_view{&digits[--count], 1});
+            }
+
+            append(templateName.substr(pos + 1));
+        }
+    }
+
+    /**
+     * Returns the name
+     */
+    constexpr std::string_view view() const
+    {
+        return std::string_view{name.data(), length};
+    }
+
+  private:
+    constexpr void append(std::string_view text)
+    {
+        for (auto c : text)
+        {
+            if (length == maxLength)
+            {
+                throw std::length_error{"PMBus attribute name too long"};
+            }
+            name[length++] = c;
+        }
+    }
+
+    std::array<char, maxLength> name{};
+    size_t length = 0;
+};
+
+/**
+ * The paged attributes whose names and paths are precomputed.
+ * Each one is an index into pagedAttributeTemplates.
+ */
+enum class PagedAttribute
+{
+    statusVout // STATUS_VOUT
+};
+
+/**
+ * The template names of the paged attributes, indexed by PagedAttribute
+ */
+inline constexpr std::array<std::string_view, 1> pagedAttributeTemplates{
+    STATUS_VOUT};
+
+/**
+ * The name of every page of every paged attribute
+ */
+inline constexpr auto pagedNames = [] {
+    std::array<std::array<PagedName, MAX_PAGES>,
+               pagedAttributeTemplates.size()>
+        names{};
+    for (size_t attribute = 0; attribute < names.size(); attribute++)
+    {
+        for (size_t page = 0; page < MAX_PAGES; page++)
+        {
+            names[attribute][page] =
+                PagedName{pagedAttributeTemplates[attribute], page};
+        }
+    }
+    return names;
+}();
+
+/**
+ * Returns the name of a paged attribute for a page, such as
+ * "status3_vout" for PagedAttribute::statusVout and page 3.
+ *
+ * Throws std::out_of_range if page is not less than MAX_PAGES.
+ *
+ * @param[in] attribute - the paged attribute
+ * @param[in] page - the page number
+ *
+ * @return string_view - the name, which is valid for the life of the
+ *                       program
+ */
+constexpr std::string_view getPagedName(PagedAttribute attribute, size_t page)
+{
+    return pagedNames.at(static_cast<size_t>(attribute)).at(page).view();
+}
+
 /**
  * @class PMBusBase
  *
@@ -172,7 +327,91 @@ class PMBusBase
 
     virtual uint64_t read(const std::string& name, Type type,
                           bool errTrace = true) = 0;
+
+    /**
+     * Reads several attributes back to back, as read() would.
+     *
+     * This is used to read related registers, such as the STATUS_*
+     * registers that roll up into STATUS_WORD, in one call.  Each one is
+     * still a separate access, so a register can change between the reads
+     * and the values aren't guaranteed to be from the same point in time.
+     *
+     * The default implementation calls read() for each attribute.
+     *
+     * @param[in] attributes - the attributes to read
+     * @param[out] values - filled in with the value of each attribute, in
+     *                      the same order.  Must be the same size as
+     *                      attributes.
+     */
+    virtual void readMany(std::span<const Attribute> attributes,
+                          std::span<uint64_t> values)
+    {
+        if (attributes.size() != values.size())
+        {
+            throw std::invalid_argument{"Attribute and value count mismatch"};
+        }
+
+        for (size_t i = 0; i < attributes.size(); ++i)
+        {
+            values[i] = read(attributes[i].name, attributes[i].type);
+        }
+    }
+
+    /**
+     * Reads a fixed list of attributes back to back.
+     *
+     * @param[in] attributes - the attributes to read
+     *
+     * @return array - the value of each attribute, in the same order
+     */
+    template <size_t N>
+    std::array<uint64_t, N>
+        readMany(const std::array<Attribute, N>& attributes)
+    {
+        std::array<uint64_t, N> values{};
+        readMany(std::span<const Attribute>{attributes},
+                 std::span<uint64_t>{values});
+        return values;
+    }
+
     virtual std::string readString(const std::string& name, Type type) = 0;
+
+    /**
+     * Reads a string without copying it.
+     *
+     * The returned view is only valid until the next call to
+     * readStringView() on this object.
+     *
+     * @param[in] name - path concatenated to basePath to read
+     * @param[in] type - Path type
+     *
+     * @return string_view - The data read from the file.
+     */
+    virtual std::string_view readStringView(const std::string& name,
+                                            Type type) = 0;
+
+    /**
+     * Opens a file so that it can be polled for changes.
+     *
+     * This is for the files the driver calls sysfs_notify() on, like the
+     * hwmon *_alarm files.  The file has already been read once, so a
+     * poll() for POLLPRI will return on the next change.  The file must
+     * be read again after that to wait for the change after it.
+     *
+     * The default implementation doesn't support this.
+     *
+     * @param[in] name - path concatenated to basePath to open
+     * @param[in] type - Path type
+     *
+     * @return FileDescriptor - the open file, or one that isn't open if
+     *                          the file could not be opened
+     */
+    virtual phosphor::power::util::FileDescriptor
+        openPollable(const std::string& /*name*/, Type /*type*/)
+    {
+        return {};
+    }
+
     virtual std::vector<uint8_t> readBinary(const std::string& name, Type type,
                                             size_t length) = 0;
     virtual void writeBinary(const std::string& name, std::vector<uint8_t> data,
@@ -209,8 +448,8 @@ class PMBus : public PMBusBase
   public:
     PMBus() = delete;
     virtual ~PMBus() = default;
-    PMBus(const PMBus&) = default;
-    PMBus& operator=(const PMBus&) = default;
+    PMBus(const PMBus&) = delete;
+    PMBus& operator=(const PMBus&) = delete;
     PMBus(PMBus&&) = default;
     PMBus& operator=(PMBus&&) = default;
 
@@ -300,6 +539,45 @@ class PMBus : public PMBusBase
     uint64_t read(const std::string& name, Type type,
                   bool errTrace = true) override;
 
+    /**
+     * Read byte(s) from the file of a paged attribute.
+     *
+     * The same as read(), but the path is looked up in a table
+     * instead of being built from the name.
+     *
+     * @param[in] attribute - the paged attribute
+     * @param[in] page - page number
+     * @param[in] type - Path type
+     * @param[in] errTrace - true to enable tracing error (defaults to true)
+     *
+     * @return uint64_t - Up to 8 bytes of data read from file.
+     */
+    uint64_t read(PagedAttribute attribute, size_t page, Type type,
+                  bool errTrace = true);
+
+    /**
+     * Checks if the file of a paged attribute exists.
+     *
+     * @param[in] attribute - the paged attribute
+     * @param[in] page - page number
+     * @param[in] type - Path type
+     *
+     * @return bool - True if file exists, false if it does not.
+     */
+    bool exists(PagedAttribute attribute, size_t page, Type type);
+
+    /**
+     * Read several attributes back to back.
+     *
+     * No paths are built for files that were read before.
+     *
+     * @param[in] attributes - the attributes to read
+     * @param[out] values - filled in with the value of each attribute
+     */
+    void readMany(std::span<const Attribute> attributes,
+                  std::span<uint64_t> values) override;
+    using PMBusBase::readMany;
+
     /**
      * Read a string from file in sysfs.
      *
@@ -310,6 +588,30 @@ class PMBus : public PMBusBase
      */
     std::string readString(const std::string& name, Type type) override;
 
+    /**
+     * Read a string from file in sysfs without allocating memory.
+     *
+     * @param[in] name   - path concatenated to basePath to read
+     * @param[in] type   - Path type
+     *
+     * @return string_view - The data read from the file.  Only valid until
+     *                       the next call to readStringView().
+     */
+    std::string_view readStringView(const std::string& name,
+                                    Type type) override;
+
+    /**
+     * Opens a file in sysfs so that it can be polled for changes.
+     *
+     * @param[in] name   - path concatenated to basePath to open
+     * @param[in] type   - Path type
+     *
+     * @return FileDescriptor - the open file, or one that isn't open if
+     *                          the file could not be opened
+     */
+    phosphor::power::util::FileDescriptor
+        openPollable(const std::string& name, Type type) override;
+
     /**
      * Read data from a binary file in sysfs.
      *
@@ -370,17 +672,45 @@ class PMBus : public PMBusBase
     /**
      * Finds the path relative to basePath to the hwmon directory
      * for the device and stores it in hwmonRelPath.
+     *
+     * The directory comes from the process-wide HwmonResolver, so it is
+     * only searched for again once the kernel reports that it changed.
+     *
+     * Any cached file descriptors and paths are dropped, since the files
+     * they refer to may have gone away if the device driver was rebound.
      */
     void findHwmonDir() override;
 
     /**
      * Returns the path to use for the passed in type.
      *
+     * The path is only built the first time it is needed,
+     * and again after findHwmonDir() is called.  If the hwmon
+     * directory wasn't found yet, it is looked for again first.
+     *
      * @param[in] type - Path type
      *
      * @return fs::path - the full path
      */
-    fs::path getPath(Type type);
+    const fs::path& getPath(Type type);
+
+    /**
+     * Returns the full path of the file for a paged attribute.
+     *
+     * The paths for all pages of an attribute are built the first
+     * time one of them is needed, so after that this is just an
+     * index lookup.
+     *
+     * Throws std::out_of_range if page is not less than MAX_PAGES.
+     *
+     * @param[in] attribute - the paged attribute
+     * @param[in] page - page number
+     * @param[in] type - Path type
+     *
+     * @return fs::path - the full path
+     */
+    const fs::path& getPagedPath(PagedAttribute attribute, size_t page,
+                                 Type type);
 
   private:
     /**
@@ -392,6 +722,101 @@ class PMBus : public PMBusBase
      */
     std::string getDeviceName();
 
+    /**
+     * Saves the hwmon directory found for the device, and drops the
+     * cached file descriptors and paths.
+     *
+     * @param[in] dir - the directory name, or an empty path if the
+     *                  device doesn't have one
+     */
+    void setHwmonDir(const fs::path& dir);
+
+    /**
+     * Reads a hexadecimal value from a file in sysfs.
+     *
+     * @param[in] dir - the directory of the file
+     * @param[in] name - the file name, relative to dir
+     * @param[in] errTrace - true to enable tracing error
+     *
+     * @return uint64_t - Up to 8 bytes of data read from file.
+     */
+    uint64_t readValue(const fs::path& dir, std::string_view name,
+                       bool errTrace);
+
+    /**
+     * Reads the contents of a file in sysfs into the buffer passed in.
+     *
+     * A file descriptor is opened on the first access to a file and is then
+     * cached, so that later reads of the same file only need a pread()
+     * instead of an open/read/close sequence.  Finding the cached
+     * descriptor doesn't build the path of the file.  The descriptor is
+     * dropped if the read fails with anything but EAGAIN or EINTR, so a
+     * descriptor left stale by a driver unbind or rebind is opened again on
+     * the next read.
+     *
+     * The time taken is recorded in the AccessStatsRegistry.
+     *
+     * @param[in] dir - the directory of the file
+     * @param[in] name - the file name, relative to dir
+     * @param[out] buffer - the buffer to read into
+     * @param[in] size - the maximum number of bytes to read
+     *
+     * @return ssize_t - the number of bytes read, or -1 on error with errno
+     *                   set appropriately
+     */
+    ssize_t readFile(const fs::path& dir, std::string_view name, char* buffer,
+                     size_t size);
+
+    /**
+     * The size of the buffer used to read a sysfs file.
+     *
+     * sysfs attributes cannot be larger than a page.
+     */
+    static constexpr size_t maxFileSize = 4096;
+
+    /**
+     * The buffer that readStringView() returns views into
+     */
+    std::array<char, maxFileSize> stringBuffer;
+
+    /**
+     * The number of path types
+     */
+    static constexpr size_t numTypes =
+        static_cast<size_t>(Type::HwmonDeviceDebug) + 1;
+
+    /**
+     * The path of each type, indexed by Type.  Empty until first used.
+     */
+    std::array<std::optional<fs::path>, numTypes> typePaths;
+
+    /**
+     * The path of every page of each paged attribute, indexed by Type and
+     * then by PagedAttribute.  Each vector is filled in on first use.
+     */
+    std::array<std::array<std::vector<fs::path>,
+                          pagedAttributeTemplates.size()>,
+               numTypes>
+        pagedPaths;
+
+    /**
+     * Holds the path returned by getPath() or getPagedPath() when it
+     * can't be saved yet because the device name isn't known.
+     */
+    fs::path uncachedPath;
+
+    /**
+     * The cached file descriptors of a directory, keyed by file name
+     */
+    using FileDescriptors =
+        std::map<std::string, phosphor::power::util::FileDescriptor,
+                 std::less<>>;
+
+    /**
+     * The cached file descriptors, keyed by directory
+     */
+    std::map<std::string, FileDescriptors, std::less<>> fileDescriptors;
+
     /**
      * The sysfs device path
      */
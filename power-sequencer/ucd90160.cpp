@@ -130,8 +130,8 @@ bool UCD90160::checkVOUTFaults()
             continue;
         }
 
-        auto statusVout = interface.insertPageNum(STATUS_VOUT, page);
-        uint8_t vout = interface.read(statusVout, Type::Debug);
+        uint8_t vout =
+            interface.read(PagedAttribute::statusVout, page, Type::Debug);
 
         // If any bits are on log them, though some are just
         // warnings so they won't cause errors
@@ -0,0 +1,170 @@
+/**
+ * Copyright © 2017 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "service_cache.hpp"
+
+#include <sdbusplus/message.hpp>
+
+#include <exception>
+
+namespace phosphor::power::util
+{
+
+namespace rules = sdbusplus::bus::match::rules;
+
+ServiceCache& ServiceCache::get()
+{
+    static ServiceCache cache;
+    return cache;
+}
+
+void ServiceCache::enable(sdbusplus::bus::bus& bus)
+{
+    if (isEnabled())
+    {
+        return;
+    }
+
+    this->bus = &bus;
+    enabled.store(true, std::memory_order_release);
+}
+
+std::optional<std::string>
+    ServiceCache::find(const std::string& path,
+                       const std::string& interface) const
+{
+    std::lock_guard lock{mutex};
+    auto it = services.find({path, interface});
+    if (it == services.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void ServiceCache::add(const std::string& path, const std::string& interface,
+                       const std::string& service)
+{
+    {
+        std::lock_guard lock{mutex};
+        services.insert_or_assign({path, interface}, service);
+    }
+
+    if (isEnabled())
+    {
+        watch(service);
+    }
+}
+
+void ServiceCache::removeService(const std::string& service)
+{
+    std::lock_guard lock{mutex};
+    std::erase_if(services, [&service](const auto& entry) {
+        return entry.second == service;
+    });
+}
+
+void ServiceCache::removePath(const std::string& path)
+{
+    std::lock_guard lock{mutex};
+    auto it = services.lower_bound({path, std::string{}});
+    while ((it != services.end()) && (it->first.first == path))
+    {
+        it = services.erase(it);
+    }
+}
+
+void ServiceCache::clear()
+{
+    std::lock_guard lock{mutex};
+    services.clear();
+}
+
+size_t ServiceCache::size() const
+{
+    std::lock_guard lock{mutex};
+    return services.size();
+}
+
+void ServiceCache::watch(const std::string& service)
+{
+    auto [it, added] = matches.try_emplace(service);
+    if (!added)
+    {
+        return;
+    }
+
+    try
+    {
+        auto& serviceMatches = it->second;
+        serviceMatches.reserve(3);
+        serviceMatches.emplace_back(
+            *bus, rules::nameOwnerChanged(service),
+            [this](auto& msg) { nameOwnerChanged(msg); });
+        serviceMatches.emplace_back(
+            *bus, rules::interfacesAdded() + rules::sender(service),
+            [this](auto& msg) { interfacesChanged(msg); });
+        serviceMatches.emplace_back(
+            *bus, rules::interfacesRemoved() + rules::sender(service),
+            [this](auto& msg) { interfacesChanged(msg); });
+    }
+    catch (const std::exception&)
+    {
+        // Entries that can't be dropped when they go stale can't be kept
+        matches.erase(it);
+        removeService(service);
+    }
+}
+
+void ServiceCache::nameOwnerChanged(sdbusplus::message::message& msg)
+{
+    try
+    {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+        msg.read(name, oldOwner, newOwner);
+
+        // The name left the bus or moved to another connection.  A name
+        // that just showed up can't be in the cache.
+        if (!oldOwner.empty())
+        {
+            removeService(name);
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Can't tell what changed, so start over
+        clear();
+    }
+}
+
+void ServiceCache::interfacesChanged(sdbusplus::message::message& msg)
+{
+    try
+    {
+        // Only the path is read, since the rest of an InterfacesAdded signal
+        // may hold property types that aren't known here
+        sdbusplus::message::object_path path;
+        msg.read(path);
+        removePath(path);
+    }
+    catch (const std::exception&)
+    {
+        clear();
+    }
+}
+
+} // namespace phosphor::power::util
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phosphor::power::util
+{
+
+/**
+ * @class ServiceCache
+ *
+ * Remembers the services the object mapper returned for D-Bus paths and
+ * interfaces, so that getService() doesn't need a blocking GetObject call
+ * each time a daemon reads or writes a property.
+ *
+ * Entries are dropped when the service that owned them leaves the bus or
+ * changes owner (NameOwnerChanged), and when that service adds interfaces to
+ * or removes them from their path (InterfacesAdded and InterfacesRemoved).
+ * The signals are only matched for the services in the cache, by name, so
+ * the program isn't woken up by every service on the bus.  Empty mapper
+ * responses aren't cached, since callers usually retry those until the
+ * object shows up.
+ *
+ * The process-wide cache isn't used by getService() until enable() is
+ * called, since the dropping relies on signals that are only seen by
+ * programs that process D-Bus events.  Short-lived tools that don't run an
+ * event loop shouldn't enable it.
+ */
+class ServiceCache
+{
+  public:
+    ServiceCache() = default;
+    ServiceCache(const ServiceCache&) = delete;
+    ServiceCache& operator=(const ServiceCache&) = delete;
+    ServiceCache(ServiceCache&&) = delete;
+    ServiceCache& operator=(ServiceCache&&) = delete;
+    ~ServiceCache() = default;
+
+    /**
+     * Gets the process-wide cache used by getService()
+     *
+     * @return ServiceCache& - the cache
+     */
+    static ServiceCache& get();
+
+    /**
+     * Starts using the cache.  From then on, the signals that make the
+     * entries of a service stale are watched once it is added.
+     *
+     * Must be called before the first lookup, on the thread that runs the
+     * event loop the bus is attached to, which is also the thread add() must
+     * be called on.  Does nothing if already enabled.
+     *
+     * @param[in] bus - the D-Bus object
+     */
+    void enable(sdbusplus::bus::bus& bus);
+
+    /**
+     * Returns whether enable() was called
+     */
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Finds the service for a path and interface
+     *
+     * @param[in] path - the D-Bus path
+     * @param[in] interface - the D-Bus interface
+     *
+     * @return std::optional<std::string> - the service, if cached
+     */
+    std::optional<std::string> find(const std::string& path,
+                                    const std::string& interface) const;
+
+    /**
+     * Adds the service for a path and interface
+     *
+     * Once enabled, starts watching the service if it isn't already.
+     *
+     * @param[in] path - the D-Bus path
+     * @param[in] interface - the D-Bus interface
+     * @param[in] service - the service the mapper returned
+     */
+    void add(const std::string& path, const std::string& interface,
+             const std::string& service);
+
+    /**
+     * Drops the entries for a service
+     *
+     * @param[in] service - the service name
+     */
+    void removeService(const std::string& service);
+
+    /**
+     * Drops the entries for a path
+     *
+     * @param[in] path - the D-Bus path
+     */
+    void removePath(const std::string& path);
+
+    /**
+     * Drops all entries
+     */
+    void clear();
+
+    /**
+     * Returns the number of entries
+     */
+    size_t size() const;
+
+  private:
+    /**
+     * Starts matching the signals of a service that make its entries stale
+     *
+     * The matches are kept after the entries are dropped, since the service
+     * is likely to be looked up again.
+     *
+     * @param[in] service - the service name
+     */
+    void watch(const std::string& service);
+
+    /**
+     * Callback for NameOwnerChanged signals
+     *
+     * @param[in] msg - the signal
+     */
+    void nameOwnerChanged(sdbusplus::message::message& msg);
+
+    /**
+     * Callback for InterfacesAdded and InterfacesRemoved signals
+     *
+     * @param[in] msg - the signal
+     */
+    void interfacesChanged(sdbusplus::message::message& msg);
+
+    /** Whether getService() uses the cache */
+    std::atomic<bool> enabled{false};
+
+    /** Protects services */
+    mutable std::mutex mutex;
+
+    /** The services, by path and interface */
+    std::map<std::pair<std::string, std::string>, std::string> services;
+
+    /** The bus the signals are matched on, once enabled */
+    sdbusplus::bus::bus* bus = nullptr;
+
+    /** The signal matches of each service watched.  Only used on the event
+     *  loop thread, so not protected by mutex. */
+    std::map<std::string, std::vector<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace phosphor::power::util
@@ -0,0 +1,118 @@
+/**
+ * Copyright © 2020 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "access_stats.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::util;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTests, Buckets)
+{
+    // Small values get a bucket each
+    EXPECT_EQ(LatencyHistogram::bucket(0), 0);
+    EXPECT_EQ(LatencyHistogram::bucket(3), 3);
+
+    // Then each power of two is split in 4
+    EXPECT_EQ(LatencyHistogram::bucket(4), 4);
+    EXPECT_EQ(LatencyHistogram::bucket(7), 7);
+    EXPECT_EQ(LatencyHistogram::bucket(8), 8);
+    EXPECT_EQ(LatencyHistogram::bucket(9), 8);
+    EXPECT_EQ(LatencyHistogram::bucket(10), 9);
+    EXPECT_EQ(LatencyHistogram::bucket(1000), 35);
+    EXPECT_EQ(LatencyHistogram::lowerBound(35), 896);
+    EXPECT_EQ(LatencyHistogram::lowerBound(36), 1024);
+
+    // Every value is in the bucket whose bounds hold it
+    for (uint64_t value : {1, 5, 17, 100, 999, 12345, 1000000})
+    {
+        auto index = LatencyHistogram::bucket(value);
+        EXPECT_LE(LatencyHistogram::lowerBound(index), value);
+        EXPECT_GT(LatencyHistogram::lowerBound(index + 1), value);
+    }
+
+    // Values that are too large go in the last bucket
+    EXPECT_EQ(LatencyHistogram::bucket(UINT64_MAX),
+              LatencyHistogram::numBuckets - 1);
+}
+
+TEST(LatencyHistogramTests, Percentile)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(50), 0);
+
+    for (int i = 0; i < 90; i++)
+    {
+        histogram.record(100us);
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        histogram.record(5ms);
+    }
+
+    EXPECT_EQ(histogram.count(), 100);
+
+    // Within the 25% bucket width
+    EXPECT_GE(histogram.percentile(50), 100);
+    EXPECT_LT(histogram.percentile(50), 125);
+    EXPECT_GE(histogram.percentile(99), 5000);
+    EXPECT_LE(histogram.percentile(99), 5000);
+    EXPECT_EQ(histogram.percentile(100), 5000);
+}
+
+TEST(AccessStatsRegistryTests, AccessTimer)
+{
+    auto& registry = AccessStatsRegistry::get();
+    registry.clear();
+
+    // Nothing is recorded until enabled
+    {
+        AccessTimer timer{"dev", "attr"};
+    }
+    EXPECT_EQ(registry.find("dev", "attr").latency.count(), 0);
+
+    registry.enable();
+    {
+        AccessTimer timer{"dev", "attr"};
+    }
+    {
+        AccessTimer timer{"dev", "attr"};
+        timer.setFailed();
+        timer.setRetries(2);
+    }
+    try
+    {
+        AccessTimer timer{"dev", "attr"};
+        throw std::runtime_error{"failed"};
+    }
+    catch (const std::exception&)
+    {}
+
+    auto stats = registry.find("dev", "attr");
+    EXPECT_EQ(stats.latency.count(), 3);
+    EXPECT_EQ(stats.errors, 2);
+    EXPECT_EQ(stats.retries, 2);
+    EXPECT_EQ(registry.find("dev", "other").latency.count(), 0);
+
+    std::ostringstream out;
+    registry.dump(out);
+    EXPECT_EQ(out.str().find("dev attr count=3 "), 0);
+    EXPECT_NE(out.str().find(" errors=2 retries=2\n"), std::string::npos);
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright © 2020 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "async_engine.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::util;
+using namespace std::chrono_literals;
+
+class AsyncEngineTests : public ::testing::Test
+{
+  protected:
+    /**
+     * Runs the event loop until the condition is true, or 5 seconds pass.
+     *
+     * @param[in] condition - the condition to wait for
+     * @return bool - the condition
+     */
+    bool runUntil(const std::function<bool()>& condition)
+    {
+        auto end = std::chrono::steady_clock::now() + 5s;
+        while (!condition() && (std::chrono::steady_clock::now() < end))
+        {
+            event.run(10ms);
+        }
+        return condition();
+    }
+
+    sdeventplus::Event event = sdeventplus::Event::get_default();
+};
+
+TEST_F(AsyncEngineTests, Submit)
+{
+    AsyncEngine engine{event, 2};
+    auto loopThread = std::this_thread::get_id();
+
+    std::thread::id workThread;
+    bool done = false;
+    engine.submit(
+        "dev", [&workThread] { workThread = std::this_thread::get_id(); },
+        [&done, loopThread](std::exception_ptr error) {
+            EXPECT_EQ(error, nullptr);
+            EXPECT_EQ(std::this_thread::get_id(), loopThread);
+            done = true;
+        });
+    EXPECT_EQ(engine.pending(), 1);
+
+    // The completion only runs on the event loop
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(done);
+
+    EXPECT_TRUE(runUntil([&done] { return done; }));
+    EXPECT_NE(workThread, loopThread);
+    EXPECT_EQ(engine.pending(), 0);
+}
+
+TEST_F(AsyncEngineTests, Exception)
+{
+    AsyncEngine engine{event, 1};
+
+    std::exception_ptr error;
+    engine.submit(
+        "dev", [] { throw std::runtime_error{"failed"}; },
+        [&error](std::exception_ptr e) { error = e; });
+
+    EXPECT_TRUE(runUntil([&error] { return error != nullptr; }));
+    EXPECT_THROW(std::rethrow_exception(error), std::runtime_error);
+}
+
+TEST_F(AsyncEngineTests, SameKeyInOrder)
+{
+    AsyncEngine engine{event, 4};
+
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    std::vector<int> order;
+    int completed = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        engine.submit(
+            "dev",
+            [&, i] {
+                if (++running > 1)
+                {
+                    overlapped = true;
+                }
+                std::this_thread::sleep_for(5ms);
+                order.push_back(i);
+                running--;
+            },
+            [&completed](std::exception_ptr) { completed++; });
+    }
+
+    EXPECT_TRUE(runUntil([&completed] { return completed == 4; }));
+    EXPECT_FALSE(overlapped);
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(AsyncEngineTests, DifferentKeysConcurrent)
+{
+    AsyncEngine engine{event, 2};
+
+    // Each job waits for the other one to start, which only works if they
+    // run at the same time.
+    std::atomic<int> started{0};
+    int together = 0;
+    auto work = [&started] {
+        started++;
+        auto end = std::chrono::steady_clock::now() + 5s;
+        while ((started < 2) && (std::chrono::steady_clock::now() < end))
+        {
+            std::this_thread::yield();
+        }
+        if (started < 2)
+        {
+            throw std::runtime_error{"Timed out"};
+        }
+    };
+    auto done = [&together](std::exception_ptr error) {
+        if (!error)
+        {
+            together++;
+        }
+    };
+
+    engine.submit("dev1", work, done);
+    engine.submit("dev2", work, done);
+
+    EXPECT_TRUE(runUntil([&engine] { return engine.pending() == 0; }));
+    EXPECT_EQ(together, 2);
+}
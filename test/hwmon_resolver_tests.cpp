@@ -0,0 +1,62 @@
+/**
+ * Copyright © 2020 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hwmon_resolver.hpp"
+
+#include <stdlib.h> // for mkdtemp()
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::pmbus;
+namespace fs = std::filesystem;
+
+class HwmonResolverTests : public ::testing::Test
+{
+  protected:
+    HwmonResolverTests()
+    {
+        char pathTemplate[] = "/tmp/hwmon_resolver_test_XXXXXX";
+        basePath = mkdtemp(pathTemplate);
+        HwmonResolver::get().clear();
+    }
+
+    ~HwmonResolverTests()
+    {
+        fs::remove_all(basePath);
+    }
+
+    fs::path basePath;
+};
+
+TEST_F(HwmonResolverTests, Find)
+{
+    auto& resolver = HwmonResolver::get();
+
+    // No hwmon directory yet
+    EXPECT_TRUE(resolver.find(basePath).empty());
+
+    // A missing directory isn't cached, so it is found once it exists
+    fs::create_directories(basePath / "hwmon" / "hwmon7");
+    EXPECT_EQ(resolver.find(basePath), "hwmon7");
+    EXPECT_EQ(resolver.find(basePath), "hwmon7");
+
+    // It is found again after the cache is cleared
+    fs::rename(basePath / "hwmon" / "hwmon7", basePath / "hwmon" / "hwmon8");
+    resolver.clear();
+    EXPECT_EQ(resolver.find(basePath), "hwmon8");
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright © 2017 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pmbus.hpp"
+
+#include <stdlib.h> // for mkdtemp()
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::pmbus;
+namespace fs = std::filesystem;
+
+class PMBusTests : public ::testing::Test
+{
+  protected:
+    PMBusTests()
+    {
+        char dirTemplate[] = "/tmp/pmbus_tests_XXXXXX";
+        dir = mkdtemp(dirTemplate);
+    }
+
+    ~PMBusTests() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+};
+
+TEST_F(PMBusTests, ReopenAfterFailedRead)
+{
+    PMBus pmbus{dir};
+
+    // A directory opens, but fails to read with EISDIR, which stands in for
+    // an attribute whose descriptor went stale
+    fs::create_directory(dir / "value");
+    EXPECT_ANY_THROW(pmbus.read("value", Type::Base, false));
+
+    // The failed descriptor was dropped, so the new file is opened
+    fs::remove(dir / "value");
+    std::ofstream{dir / "value"} << "0x1f\n";
+    EXPECT_EQ(pmbus.read("value", Type::Base, false), 0x1f);
+}
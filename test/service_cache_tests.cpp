@@ -0,0 +1,68 @@
+/**
+ * Copyright © 2020 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "service_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::util;
+
+TEST(ServiceCacheTests, Find)
+{
+    ServiceCache cache;
+    EXPECT_FALSE(cache.isEnabled());
+    EXPECT_FALSE(cache.find("/a", "xyz.Item"));
+
+    cache.add("/a", "xyz.Item", "xyz.Inventory");
+    cache.add("/a", "xyz.Asset", "xyz.VPD");
+    EXPECT_EQ(cache.find("/a", "xyz.Item"), "xyz.Inventory");
+    EXPECT_EQ(cache.find("/a", "xyz.Asset"), "xyz.VPD");
+    EXPECT_FALSE(cache.find("/a", "xyz.Other"));
+    EXPECT_FALSE(cache.find("/b", "xyz.Item"));
+
+    // A newer mapper response replaces the old one
+    cache.add("/a", "xyz.Item", "xyz.Other");
+    EXPECT_EQ(cache.find("/a", "xyz.Item"), "xyz.Other");
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ServiceCacheTests, Remove)
+{
+    ServiceCache cache;
+    cache.add("/a", "xyz.Item", "xyz.Inventory");
+    cache.add("/a", "xyz.Asset", "xyz.VPD");
+    cache.add("/a/b", "xyz.Item", "xyz.Inventory");
+    cache.add("/ab", "xyz.Item", "xyz.Inventory");
+    cache.add("/c", "xyz.Asset", "xyz.VPD");
+
+    // Only the exact path is dropped
+    cache.removePath("/a");
+    EXPECT_FALSE(cache.find("/a", "xyz.Item"));
+    EXPECT_FALSE(cache.find("/a", "xyz.Asset"));
+    EXPECT_EQ(cache.find("/a/b", "xyz.Item"), "xyz.Inventory");
+    EXPECT_EQ(cache.find("/ab", "xyz.Item"), "xyz.Inventory");
+    EXPECT_EQ(cache.size(), 3);
+
+    cache.removeService("xyz.Inventory");
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.find("/c", "xyz.Asset"), "xyz.VPD");
+
+    cache.removePath("/missing");
+    cache.removeService("xyz.Missing");
+    EXPECT_EQ(cache.size(), 1);
+}
@@ -0,0 +1,98 @@
+#include "async_i2c.hpp"
+
+#include <linux/i2c.h>
+
+namespace i2c
+{
+
+AsyncI2C::AsyncI2C(phosphor::power::util::AsyncEngine& engine,
+                   std::unique_ptr<I2CInterface> interface, uint8_t busId) :
+    engine(engine),
+    interface(std::move(interface)), key("/dev/i2c-" + std::to_string(busId))
+{}
+
+void AsyncI2C::run(Operation operation, Done done)
+{
+    engine.submit(
+        key,
+        [interface = interface, operation = std::move(operation)] {
+            operation(*interface);
+        },
+        std::move(done));
+}
+
+void AsyncI2C::read(uint8_t addr, ReadDone<uint8_t> done)
+{
+    runRead<uint8_t>(
+        [addr](I2CInterface& i2c) {
+            uint8_t data = 0;
+            i2c.read(addr, data);
+            return data;
+        },
+        std::move(done));
+}
+
+void AsyncI2C::readWord(uint8_t addr, ReadDone<uint16_t> done)
+{
+    runRead<uint16_t>(
+        [addr](I2CInterface& i2c) {
+            uint16_t data = 0;
+            i2c.read(addr, data);
+            return data;
+        },
+        std::move(done));
+}
+
+void AsyncI2C::read(uint8_t addr, uint8_t size, I2CInterface::Mode mode,
+                    ReadDone<std::vector<uint8_t>> done)
+{
+    runRead<std::vector<uint8_t>>(
+        [addr, size, mode](I2CInterface& i2c) {
+            // The device may send up to 32 bytes in SMBus mode
+            std::vector<uint8_t> data(
+                (mode == I2CInterface::Mode::SMBUS) ? I2C_SMBUS_BLOCK_MAX
+                                                    : size);
+            uint8_t count = size;
+            i2c.read(addr, count, data.data(), mode);
+            data.resize(count);
+            return data;
+        },
+        std::move(done));
+}
+
+void AsyncI2C::readRange(uint8_t addr, size_t count,
+                         ReadDone<std::vector<uint8_t>> done)
+{
+    runRead<std::vector<uint8_t>>(
+        [addr, count](I2CInterface& i2c) {
+            std::vector<uint8_t> data(count);
+            i2c.readRange(addr, data);
+            return data;
+        },
+        std::move(done));
+}
+
+void AsyncI2C::write(uint8_t addr, uint8_t data, Done done)
+{
+    run([addr, data](I2CInterface& i2c) { i2c.write(addr, data); },
+        std::move(done));
+}
+
+void AsyncI2C::writeWord(uint8_t addr, uint16_t data, Done done)
+{
+    run([addr, data](I2CInterface& i2c) { i2c.write(addr, data); },
+        std::move(done));
+}
+
+void AsyncI2C::write(uint8_t addr, std::vector<uint8_t> data,
+                     I2CInterface::Mode mode, Done done)
+{
+    run(
+        [addr, data = std::move(data), mode](I2CInterface& i2c) {
+            i2c.write(addr, static_cast<uint8_t>(data.size()), data.data(),
+                      mode);
+        },
+        std::move(done));
+}
+
+} // namespace i2c
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "async_engine.hpp"
+#include "i2c_interface.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace i2c
+{
+
+/** @brief Runs the operations of an I2CInterface without blocking
+ *
+ * Each operation runs on a worker thread of an AsyncEngine, and its
+ * completion function is then called on the sdeventplus event loop the
+ * engine was created with.  The engine wakes the loop through an eventfd,
+ * so a daemon keeps handling D-Bus while a slow device is being read.
+ *
+ * Operations are queued per bus: the operations of all the AsyncI2C objects
+ * on a bus run one at a time, in the order they were started, like they
+ * would on a worker thread for the bus.  Operations on different buses may
+ * run at the same time.
+ *
+ * A sequence of steps is written by starting each step from the completion
+ * function of the one before, and a delay between steps by starting the next
+ * step from an sdeventplus timer instead of sleeping.
+ */
+class AsyncI2C
+{
+  public:
+    AsyncI2C(const AsyncI2C&) = delete;
+    AsyncI2C& operator=(const AsyncI2C&) = delete;
+    AsyncI2C(AsyncI2C&&) = default;
+    AsyncI2C& operator=(AsyncI2C&&) = delete;
+    ~AsyncI2C() = default;
+
+    /** @brief Called on the event loop after an operation, with the
+     *         exception it threw, if any */
+    using Done = std::function<void(std::exception_ptr)>;
+
+    /** @brief Called on the event loop after a read, with the exception it
+     *         threw, if any, and the value read */
+    template <typename T>
+    using ReadDone = std::function<void(std::exception_ptr, T)>;
+
+    /** @brief An operation on the interface, run on a worker thread */
+    using Operation = std::function<void(I2CInterface&)>;
+
+    /** @brief Constructor
+     *
+     * @param[in] engine - The engine to run operations on, which must outlive
+     *                     this object
+     * @param[in] interface - The interface to the device
+     * @param[in] busId - The i2c bus ID of the device
+     */
+    AsyncI2C(phosphor::power::util::AsyncEngine& engine,
+             std::unique_ptr<I2CInterface> interface, uint8_t busId);
+
+    /** @brief Run an operation on the interface
+     *
+     * The interface is kept alive until the operation is done, even if this
+     * object is destroyed first.
+     *
+     * @param[in] operation - The operation
+     * @param[in] done - Called on the event loop after the operation
+     */
+    void run(Operation operation, Done done);
+
+    /** @brief Read byte data
+     *
+     * @param[in] addr - The register address of the i2c device
+     * @param[in] done - Called with the byte read
+     */
+    void read(uint8_t addr, ReadDone<uint8_t> done);
+
+    /** @brief Read word data
+     *
+     * @param[in] addr - The register address of the i2c device
+     * @param[in] done - Called with the word read
+     */
+    void readWord(uint8_t addr, ReadDone<uint16_t> done);
+
+    /** @brief Read block data
+     *
+     * @param[in] addr - The register address of the i2c device
+     * @param[in] size - The number of bytes to read in I2C mode; ignored
+     *                   in SMBus mode, where the device sends the count
+     * @param[in] mode - The block read mode, either SMBus or I2C
+     * @param[in] done - Called with the bytes read
+     */
+    void read(uint8_t addr, uint8_t size, I2CInterface::Mode mode,
+              ReadDone<std::vector<uint8_t>> done);
+
+    /** @brief Read a range of consecutive registers
+     *
+     * @param[in] addr - The register address of the first byte
+     * @param[in] count - The number of registers to read
+     * @param[in] done - Called with the bytes read
+     */
+    void readRange(uint8_t addr, size_t count,
+                   ReadDone<std::vector<uint8_t>> done);
+
+    /** @brief Write byte data
+     *
+     * @param[in] addr - The register address of the i2c device
+     * @param[in] data - The data to write to the i2c device
+     * @param[in] done - Called after the write
+     */
+    void write(uint8_t addr, uint8_t data, Done done);
+
+    /** @brief Write word data
+     *
+     * @param[in] addr - The register address of the i2c device
+     * @param[in] data - The data to write to the i2c device
+     * @param[in] done - Called after the write
+     */
+    void writeWord(uint8_t addr, uint16_t data, Done done);
+
+    /** @brief Write block data
+     *
+     * @param[in] addr - The register address of the i2c device
+     * @param[in] data - The data to write to the i2c device, at most 32
+     *                   bytes
+     * @param[in] mode - The block write mode, either SMBus or I2C
+     * @param[in] done - Called after the write
+     */
+    void write(uint8_t addr, std::vector<uint8_t> data,
+               I2CInterface::Mode mode, Done done);
+
+  private:
+    /** @brief Run an operation that returns a value
+     *
+     * @param[in] operation - The operation
+     * @param[in] done - Called with the value, or a default value if the
+     *                   operation threw
+     */
+    template <typename T>
+    void runRead(std::function<T(I2CInterface&)> operation,
+                 ReadDone<T> done)
+    {
+        // The worker fills in the value before the completion runs
+        auto value = std::make_shared<T>();
+        run(
+            [operation = std::move(operation), value](I2CInterface& i2c) {
+                *value = operation(i2c);
+            },
+            [done = std::move(done), value](std::exception_ptr error) {
+                done(error, std::move(*value));
+            });
+    }
+
+    /** @brief The engine operations run on */
+    phosphor::power::util::AsyncEngine& engine;
+
+    /** @brief The interface, shared with the operations not done yet */
+    std::shared_ptr<I2CInterface> interface;
+
+    /** @brief The key operations are queued on, one per bus */
+    std::string key;
+};
+
+} // namespace i2c
@@ -1,12 +1,21 @@
 #include "i2c.hpp"
 
+#include "access_stats.hpp"
+#include "i2c_scheduler.hpp"
+#include "i2c_trace.hpp"
+
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-#include <cassert>
+#include <algorithm>
+#include <array>
 #include <cerrno>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
 
 extern "C"
 {
@@ -18,116 +27,235 @@ extern "C"
 namespace i2c
 {
 
+using phosphor::power::util::AccessTimer;
+
+namespace
+{
+
+/**
+ * The attribute name an access is recorded under, like "0x8B read word data"
+ */
+class AccessName
+{
+  public:
+    AccessName(std::string_view operation)
+    {
+        size = std::min(operation.size(), buffer.size());
+        std::copy_n(operation.begin(), size, buffer.begin());
+    }
+
+    AccessName(uint8_t command, std::string_view operation)
+    {
+        auto length = std::snprintf(buffer.data(), buffer.size(), "0x%02X %.*s",
+                                    command, static_cast<int>(operation.size()),
+                                    operation.data());
+        size = std::min(static_cast<size_t>(std::max(length, 0)),
+                        buffer.size() - 1);
+    }
+
+    std::string_view view() const
+    {
+        return {buffer.data(), size};
+    }
+
+  private:
+    std::array<char, 32> buffer;
+    size_t size = 0;
+};
+
+/**
+ * Returns the number of bytes a transaction put on the bus over all its
+ * attempts: an address byte per message, and the data bytes, including the
+ * command code and block count.
+ */
+size_t busBytes(size_t messages, size_t dataBytes, int retries)
+{
+    return (messages + dataBytes) * (retries + 1);
+}
+
+/**
+ * Records a transaction in the process's I2C trace.  The data of a failed
+ * read is left out.  errno is left as it was, since callers report it after.
+ */
+void trace(uint8_t bus, uint8_t address, I2CTrace::Operation operation,
+           uint8_t command, const uint8_t* data, size_t size, int ret,
+           int retries)
+{
+    auto& i2cTrace = I2CTrace::get();
+    if (!i2cTrace.isEnabled())
+    {
+        return;
+    }
+
+    int error = errno;
+    bool isRead = (operation <= I2CTrace::Operation::readI2CBlockData);
+    if ((ret < 0) && isRead)
+    {
+        size = 0;
+    }
+
+    I2CTrace::Record record;
+    record.bus = bus;
+    record.address = address;
+    record.command = command;
+    record.operation = operation;
+    record.size = static_cast<uint8_t>(std::min(size, size_t{UINT8_MAX}));
+    record.retries = static_cast<uint8_t>(std::min(retries, UINT8_MAX));
+    record.result = (ret < 0) ? static_cast<int16_t>(-error) : 0;
+    std::copy_n(data, std::min(size, I2CTrace::dataBytes),
+                record.data.begin());
+    i2cTrace.record(record);
+
+    errno = error;
+}
+
+/**
+ * Records a byte or word transaction, whose data is the value returned by
+ * the libi2c function, or the value written.
+ */
+void trace(uint8_t bus, uint8_t address, I2CTrace::Operation operation,
+           uint8_t command, int value, size_t size, int ret, int retries)
+{
+    std::array<uint8_t, 2> bytes{static_cast<uint8_t>(value),
+                                 static_cast<uint8_t>(value >> 8)};
+    trace(bus, address, operation, command, bytes.data(), size, ret, retries);
+}
+
+/**
+ * The adapter functionality bit of each I2CDevice::Transaction
+ */
+constexpr std::array<unsigned long, 11> transactionFuncs{
+    I2C_FUNC_SMBUS_READ_BYTE,       I2C_FUNC_SMBUS_READ_BYTE_DATA,
+    I2C_FUNC_SMBUS_READ_WORD_DATA,  I2C_FUNC_SMBUS_READ_BLOCK_DATA,
+    I2C_FUNC_SMBUS_READ_I2C_BLOCK,  I2C_FUNC_SMBUS_WRITE_BYTE,
+    I2C_FUNC_SMBUS_WRITE_BYTE_DATA, I2C_FUNC_SMBUS_WRITE_WORD_DATA,
+    I2C_FUNC_SMBUS_WRITE_BLOCK_DATA, I2C_FUNC_SMBUS_WRITE_I2C_BLOCK,
+    I2C_FUNC_I2C};
+
+/**
+ * The error message when the adapter doesn't support a transaction
+ */
+constexpr std::array<const char*, 11> missingMessages{
+    "Missing SMBUS_READ_BYTE",
+    "Missing SMBUS_READ_BYTE_DATA",
+    "Missing SMBUS_READ_WORD_DATA",
+    "Missing SMBUS_READ_BLOCK_DATA",
+    "Missing I2C_FUNC_SMBUS_READ_I2C_BLOCK",
+    "Missing SMBUS_WRITE_BYTE",
+    "Missing SMBUS_WRITE_BYTE_DATA",
+    "Missing SMBUS_WRITE_WORD_DATA",
+    "Missing SMBUS_WRITE_BLOCK_DATA",
+    "Missing I2C_FUNC_SMBUS_WRITE_I2C_BLOCK",
+    "Missing I2C_FUNC_I2C"};
+
+} // namespace
+
+template <typename Operation>
+int I2CDevice::runWithRetries(Operation operation, int& retries)
+{
+    if (!breaker.allow(*retryPolicy))
+    {
+        throw I2CException("Device parked after " +
+                               std::to_string(breaker.getFailures()) +
+                               " failed operations, " +
+                               std::to_string(
+                                   breaker.getParkTimeLeft().count()) +
+                               "ms left",
+                           busStr, devAddr, EAGAIN);
+    }
+
+    retries = 0;
+    int ret = operation();
+    while (ret < 0)
+    {
+        int error = errno;
+        auto delay = retryPolicy->retryDelay(retries, error);
+        if (!delay)
+        {
+            breaker.failure(*retryPolicy);
+
+            // Callers report the errno of the last attempt
+            errno = error;
+            return ret;
+        }
+
+        if (delay->count() > 0)
+        {
+            std::this_thread::sleep_for(*delay);
+        }
+        retries++;
+        ret = operation();
+    }
+
+    breaker.success();
+    return ret;
+}
+
 unsigned long I2CDevice::getFuncs()
 {
+    // Another device using the same handle may have read it already
+    unsigned long funcs = handle->funcs;
+
     // If functionality has not been cached
-    if (cachedFuncs == NO_FUNCS)
+    if (funcs == NO_FUNCS)
     {
         // Get functionality from adapter
         int ret = 0, retries = 0;
         do
         {
-            ret = ioctl(fd, I2C_FUNCS, &cachedFuncs);
+            ret = ioctl(fd, I2C_FUNCS, &funcs);
         } while ((ret < 0) && (++retries <= maxRetries));
 
         if (ret < 0)
         {
             throw I2CException("Failed to get funcs", busStr, devAddr, errno);
         }
+
+        handle->funcs = funcs;
     }
 
-    return cachedFuncs;
+    return funcs;
 }
 
-void I2CDevice::checkReadFuncs(int type)
+void I2CDevice::resolveMethods()
 {
+    static_assert(transactionFuncs.size() == TRANSACTION_COUNT);
+    static_assert(missingMessages.size() == TRANSACTION_COUNT);
+
     unsigned long funcs = getFuncs();
-    switch (type)
+
+    if (pec && !(funcs & I2C_FUNC_SMBUS_PEC))
     {
-        case I2C_SMBUS_BYTE:
-            if (!(funcs & I2C_FUNC_SMBUS_READ_BYTE))
-            {
-                throw I2CException("Missing SMBUS_READ_BYTE", busStr, devAddr);
-            }
-            break;
-        case I2C_SMBUS_BYTE_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_READ_BYTE_DATA))
-            {
-                throw I2CException("Missing SMBUS_READ_BYTE_DATA", busStr,
-                                   devAddr);
-            }
-            break;
-        case I2C_SMBUS_WORD_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_READ_WORD_DATA))
-            {
-                throw I2CException("Missing SMBUS_READ_WORD_DATA", busStr,
-                                   devAddr);
-            }
-            break;
-        case I2C_SMBUS_BLOCK_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_READ_BLOCK_DATA))
-            {
-                throw I2CException("Missing SMBUS_READ_BLOCK_DATA", busStr,
-                                   devAddr);
-            }
-            break;
-        case I2C_SMBUS_I2C_BLOCK_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_READ_I2C_BLOCK))
-            {
-                throw I2CException("Missing I2C_FUNC_SMBUS_READ_I2C_BLOCK",
-                                   busStr, devAddr);
-            }
-            break;
-        default:
-            fprintf(stderr, "Unexpected read size type: %d\n", type);
-            assert(false);
-            break;
+        throw I2CException("Missing SMBUS_PEC", busStr, devAddr);
     }
-}
 
-void I2CDevice::checkWriteFuncs(int type)
-{
-    unsigned long funcs = getFuncs();
-    switch (type)
+    for (size_t i = 0; i < TRANSACTION_COUNT; i++)
     {
-        case I2C_SMBUS_BYTE:
-            if (!(funcs & I2C_FUNC_SMBUS_WRITE_BYTE))
-            {
-                throw I2CException("Missing SMBUS_WRITE_BYTE", busStr, devAddr);
-            }
-            break;
-        case I2C_SMBUS_BYTE_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_WRITE_BYTE_DATA))
-            {
-                throw I2CException("Missing SMBUS_WRITE_BYTE_DATA", busStr,
-                                   devAddr);
-            }
-            break;
-        case I2C_SMBUS_WORD_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_WRITE_WORD_DATA))
-            {
-                throw I2CException("Missing SMBUS_WRITE_WORD_DATA", busStr,
-                                   devAddr);
-            }
-            break;
-        case I2C_SMBUS_BLOCK_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_WRITE_BLOCK_DATA))
-            {
-                throw I2CException("Missing SMBUS_WRITE_BLOCK_DATA", busStr,
-                                   devAddr);
-            }
-            break;
-        case I2C_SMBUS_I2C_BLOCK_DATA:
-            if (!(funcs & I2C_FUNC_SMBUS_WRITE_I2C_BLOCK))
-            {
-                throw I2CException("Missing I2C_FUNC_SMBUS_WRITE_I2C_BLOCK",
-                                   busStr, devAddr);
-            }
-            break;
-        default:
-            fprintf(stderr, "Unexpected write size type: %d\n", type);
-            assert(false);
+        methods[i] = (funcs & transactionFuncs[i]) ? Method::NATIVE
+                                                   : Method::MISSING;
     }
+
+    // I2C block transactions are plain I2C messages, so they can be done
+    // with I2C_RDWR on adapters without the SMBus emulation of them
+    for (auto transaction : {READ_I2C_BLOCK, WRITE_I2C_BLOCK})
+    {
+        if ((methods[transaction] == Method::MISSING) &&
+            (methods[RDWR] == Method::NATIVE))
+        {
+            methods[transaction] = Method::TRANSFER;
+        }
+    }
+}
+
+void I2CDevice::throwMissing(Transaction transaction) const
+{
+    throw I2CException(missingMessages[transaction], busStr, devAddr);
+}
+
+int I2CDevice::rdwr(i2c_msg* msgs, size_t count)
+{
+    i2c_rdwr_ioctl_data data{msgs, static_cast<uint32_t>(count)};
+    return ioctl(fd, I2C_RDWR, &data);
 }
 
 void I2CDevice::open()
@@ -137,62 +265,77 @@ void I2CDevice::open()
         throw I2CException("Device already open", busStr, devAddr);
     }
 
-    int retries = 0;
-    do
-    {
-        fd = ::open(busStr.c_str(), O_RDWR);
-    } while ((fd == -1) && (++retries <= maxRetries));
+    // Devices at the same address share one open file
+    handle = I2CHandlePool::get().acquire(busStr, busId, devAddr, pec,
+                                          maxRetries);
+    fd = handle->fd;
 
-    if (fd == -1)
+    // Decide how each transaction is done now, so they don't check the
+    // adapter functionality every time
+    try
     {
-        throw I2CException("Failed to open", busStr, devAddr, errno);
+        resolveMethods();
     }
-
-    retries = 0;
-    int ret = 0;
-    do
-    {
-        ret = ioctl(fd, I2C_SLAVE, devAddr);
-    } while ((ret < 0) && (++retries <= maxRetries));
-
-    if (ret < 0)
+    catch (...)
     {
-        // Close device since setting slave address failed
         closeWithoutException();
+        throw;
+    }
+}
 
-        throw I2CException("Failed to set I2C_SLAVE", busStr, devAddr, errno);
+BusScheduler::Turn I2CDevice::takeTurn()
+{
+    if (!BusScheduler::admit(*bus))
+    {
+        throw I2CThrottledException(busStr, devAddr);
     }
+    return BusScheduler::acquire(*bus);
 }
 
 void I2CDevice::close()
 {
     checkIsOpen();
 
-    int ret = 0, retries = 0;
-    do
-    {
-        ret = ::close(fd);
-    } while ((ret == -1) && (++retries <= maxRetries));
+    // The pool keeps the file open so the device can be reopened quickly
+    handle.reset();
+    fd = INVALID_FD;
+    methods.fill(Method::MISSING);
+}
 
-    if (ret == -1)
+void I2CDevice::setPEC(bool enabled)
+{
+    if (enabled == pec)
     {
-        throw I2CException("Failed to close", busStr, devAddr, errno);
+        return;
     }
 
-    fd = INVALID_FD;
-    cachedFuncs = NO_FUNCS;
+    // PEC is set on the file, so devices with and without it use different
+    // handles
+    pec = enabled;
+    if (isOpen())
+    {
+        close();
+        open();
+    }
 }
 
 void I2CDevice::read(uint8_t& data)
 {
     checkIsOpen();
-    checkReadFuncs(I2C_SMBUS_BYTE);
+    getMethod(READ_BYTE);
 
-    int ret = 0, retries = 0;
-    do
-    {
-        ret = i2c_smbus_read_byte(fd);
-    } while ((ret < 0) && (++retries <= maxRetries));
+    auto turn = takeTurn();
+
+    AccessName name{"read byte"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries([&] { return i2c_smbus_read_byte(fd); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(1, 1, retries));
+    trace(busId, devAddr, I2CTrace::Operation::readByte, 0, ret, sizeof(data),
+          ret, retries);
 
     if (ret < 0)
     {
@@ -205,13 +348,21 @@ void I2CDevice::read(uint8_t& data)
 void I2CDevice::read(uint8_t addr, uint8_t& data)
 {
     checkIsOpen();
-    checkReadFuncs(I2C_SMBUS_BYTE_DATA);
+    getMethod(READ_BYTE_DATA);
 
-    int ret = 0, retries = 0;
-    do
-    {
-        ret = i2c_smbus_read_byte_data(fd, addr);
-    } while ((ret < 0) && (++retries <= maxRetries));
+    auto turn = takeTurn();
+
+    AccessName name{addr, "read byte data"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries(
+        [&] { return i2c_smbus_read_byte_data(fd, addr); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(2, 2, retries));
+    trace(busId, devAddr, I2CTrace::Operation::readByteData, addr, ret,
+          sizeof(data), ret, retries);
 
     if (ret < 0)
     {
@@ -224,13 +375,21 @@ void I2CDevice::read(uint8_t addr, uint8_t& data)
 void I2CDevice::read(uint8_t addr, uint16_t& data)
 {
     checkIsOpen();
-    checkReadFuncs(I2C_SMBUS_WORD_DATA);
+    getMethod(READ_WORD_DATA);
 
-    int ret = 0, retries = 0;
-    do
-    {
-        ret = i2c_smbus_read_word_data(fd, addr);
-    } while ((ret < 0) && (++retries <= maxRetries));
+    auto turn = takeTurn();
+
+    AccessName name{addr, "read word data"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries(
+        [&] { return i2c_smbus_read_word_data(fd, addr); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(2, 3, retries));
+    trace(busId, devAddr, I2CTrace::Operation::readWordData, addr, ret,
+          sizeof(data), ret, retries);
 
     if (ret < 0)
     {
@@ -244,22 +403,48 @@ void I2CDevice::read(uint8_t addr, uint8_t& size, uint8_t* data, Mode mode)
 {
     checkIsOpen();
 
+    auto turn = takeTurn();
+
+    AccessName name{addr, "read block data"};
+    AccessTimer timer{statsName, name.view()};
+
     int ret = -1, retries = 0;
     switch (mode)
     {
         case Mode::SMBUS:
-            checkReadFuncs(I2C_SMBUS_BLOCK_DATA);
-            do
-            {
-                ret = i2c_smbus_read_block_data(fd, addr, data);
-            } while ((ret < 0) && (++retries <= maxRetries));
+            getMethod(READ_BLOCK_DATA);
+            ret = runWithRetries(
+                [&] { return i2c_smbus_read_block_data(fd, addr, data); },
+                retries);
+            turn.transferred(busBytes(2, 2 + std::max(ret, 0), retries));
+            trace(busId, devAddr, I2CTrace::Operation::readBlockData, addr,
+                  data, std::max(ret, 0), ret, retries);
             break;
         case Mode::I2C:
-            checkReadFuncs(I2C_SMBUS_I2C_BLOCK_DATA);
-            do
+            if (getMethod(READ_I2C_BLOCK) == Method::TRANSFER)
+            {
+                std::array<i2c_msg, 2> msgs{
+                    i2c_msg{devAddr, 0, 1, &addr},
+                    i2c_msg{devAddr, I2C_M_RD, size, data}};
+                ret = runWithRetries(
+                    [&] { return rdwr(msgs.data(), msgs.size()); }, retries);
+                if (ret >= 0)
+                {
+                    ret = size;
+                }
+            }
+            else
             {
-                ret = i2c_smbus_read_i2c_block_data(fd, addr, size, data);
-            } while ((ret < 0) && (++retries <= maxRetries));
+                ret = runWithRetries(
+                    [&] {
+                        return i2c_smbus_read_i2c_block_data(fd, addr, size,
+                                                             data);
+                    },
+                    retries);
+            }
+            turn.transferred(busBytes(2, 1 + size, retries));
+            trace(busId, devAddr, I2CTrace::Operation::readI2CBlockData, addr,
+                  data, size, ret, retries);
             if (ret != size)
             {
                 throw I2CException("Failed to read i2c block data", busStr,
@@ -268,6 +453,8 @@ void I2CDevice::read(uint8_t addr, uint8_t& size, uint8_t* data, Mode mode)
             break;
     }
 
+    timer.setRetries(retries);
+
     if (ret < 0)
     {
         throw I2CException("Failed to read block data", busStr, devAddr, errno);
@@ -276,16 +463,46 @@ void I2CDevice::read(uint8_t addr, uint8_t& size, uint8_t* data, Mode mode)
     size = static_cast<uint8_t>(ret);
 }
 
-void I2CDevice::write(uint8_t data)
+void I2CDevice::readRange(uint8_t addr, std::span<uint8_t> data)
 {
     checkIsOpen();
-    checkWriteFuncs(I2C_SMBUS_BYTE);
 
-    int ret = 0, retries = 0;
-    do
+    if (data.size() > size_t{UINT8_MAX} + 1 - addr)
     {
-        ret = i2c_smbus_write_byte(fd, data);
-    } while ((ret < 0) && (++retries <= maxRetries));
+        throw I2CException("Invalid register range", busStr, devAddr, EINVAL);
+    }
+
+    // Each block read takes its own turn on the bus and keeps the retries
+    // of a single read
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        auto size = static_cast<uint8_t>(
+            std::min(data.size() - offset, size_t{I2C_SMBUS_BLOCK_MAX}));
+        read(static_cast<uint8_t>(addr + offset), size, &data[offset],
+             Mode::I2C);
+        offset += size;
+    }
+}
+
+void I2CDevice::write(uint8_t data)
+{
+    checkIsOpen();
+    getMethod(WRITE_BYTE);
+
+    auto turn = takeTurn();
+
+    AccessName name{"write byte"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries(
+        [&] { return i2c_smbus_write_byte(fd, data); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(1, 1, retries));
+    trace(busId, devAddr, I2CTrace::Operation::writeByte, 0, data,
+          sizeof(data), ret, retries);
 
     if (ret < 0)
     {
@@ -296,13 +513,21 @@ void I2CDevice::write(uint8_t data)
 void I2CDevice::write(uint8_t addr, uint8_t data)
 {
     checkIsOpen();
-    checkWriteFuncs(I2C_SMBUS_BYTE_DATA);
+    getMethod(WRITE_BYTE_DATA);
 
-    int ret = 0, retries = 0;
-    do
-    {
-        ret = i2c_smbus_write_byte_data(fd, addr, data);
-    } while ((ret < 0) && (++retries <= maxRetries));
+    auto turn = takeTurn();
+
+    AccessName name{addr, "write byte data"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries(
+        [&] { return i2c_smbus_write_byte_data(fd, addr, data); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(1, 2, retries));
+    trace(busId, devAddr, I2CTrace::Operation::writeByteData, addr, data,
+          sizeof(data), ret, retries);
 
     if (ret < 0)
     {
@@ -313,13 +538,21 @@ void I2CDevice::write(uint8_t addr, uint8_t data)
 void I2CDevice::write(uint8_t addr, uint16_t data)
 {
     checkIsOpen();
-    checkWriteFuncs(I2C_SMBUS_WORD_DATA);
+    getMethod(WRITE_WORD_DATA);
 
-    int ret = 0, retries = 0;
-    do
-    {
-        ret = i2c_smbus_write_word_data(fd, addr, data);
-    } while ((ret < 0) && (++retries <= maxRetries));
+    auto turn = takeTurn();
+
+    AccessName name{addr, "write word data"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries(
+        [&] { return i2c_smbus_write_word_data(fd, addr, data); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(1, 3, retries));
+    trace(busId, devAddr, I2CTrace::Operation::writeWordData, addr, data,
+          sizeof(data), ret, retries);
 
     if (ret < 0)
     {
@@ -332,25 +565,53 @@ void I2CDevice::write(uint8_t addr, uint8_t size, const uint8_t* data,
 {
     checkIsOpen();
 
+    auto turn = takeTurn();
+
+    AccessName name{addr, "write block data"};
+    AccessTimer timer{statsName, name.view()};
+
     int ret = -1, retries = 0;
     switch (mode)
     {
         case Mode::SMBUS:
-            checkWriteFuncs(I2C_SMBUS_BLOCK_DATA);
-            do
-            {
-                ret = i2c_smbus_write_block_data(fd, addr, size, data);
-            } while ((ret < 0) && (++retries <= maxRetries));
+            getMethod(WRITE_BLOCK_DATA);
+            ret = runWithRetries(
+                [&] {
+                    return i2c_smbus_write_block_data(fd, addr, size, data);
+                },
+                retries);
+            turn.transferred(busBytes(1, 2 + size, retries));
+            trace(busId, devAddr, I2CTrace::Operation::writeBlockData, addr,
+                  data, size, ret, retries);
             break;
         case Mode::I2C:
-            checkWriteFuncs(I2C_SMBUS_I2C_BLOCK_DATA);
-            do
+            if (getMethod(WRITE_I2C_BLOCK) == Method::TRANSFER)
+            {
+                // The command code and data go in one message
+                std::array<uint8_t, UINT8_MAX + 1> buffer;
+                buffer[0] = addr;
+                std::copy_n(data, size, buffer.begin() + 1);
+                i2c_msg msg{devAddr, 0, static_cast<uint16_t>(size + 1),
+                            buffer.data()};
+                ret = runWithRetries([&] { return rdwr(&msg, 1); }, retries);
+            }
+            else
             {
-                ret = i2c_smbus_write_i2c_block_data(fd, addr, size, data);
-            } while ((ret < 0) && (++retries <= maxRetries));
+                ret = runWithRetries(
+                    [&] {
+                        return i2c_smbus_write_i2c_block_data(fd, addr, size,
+                                                              data);
+                    },
+                    retries);
+            }
+            turn.transferred(busBytes(1, 1 + size, retries));
+            trace(busId, devAddr, I2CTrace::Operation::writeI2CBlockData,
+                  addr, data, size, ret, retries);
             break;
     }
 
+    timer.setRetries(retries);
+
     if (ret < 0)
     {
         throw I2CException("Failed to write block data", busStr, devAddr,
@@ -358,6 +619,53 @@ void I2CDevice::write(uint8_t addr, uint8_t size, const uint8_t* data,
     }
 }
 
+void I2CDevice::transfer(std::span<const Message> messages)
+{
+    checkIsOpen();
+
+    getMethod(RDWR);
+
+    if (messages.empty() || (messages.size() > maxMessages))
+    {
+        throw I2CException("Invalid message count", busStr, devAddr, EINVAL);
+    }
+
+    std::array<i2c_msg, maxMessages> msgs;
+    size_t dataBytes = 0;
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        const auto& message = messages[i];
+        dataBytes += message.size;
+        msgs[i].addr = devAddr;
+        msgs[i].flags = message.isRead ? I2C_M_RD : 0;
+        msgs[i].len = message.size;
+        msgs[i].buf = message.data;
+    }
+
+    auto turn = takeTurn();
+
+    AccessName name{"transfer"};
+    AccessTimer timer{statsName, name.view()};
+
+    int retries = 0;
+    int ret = runWithRetries(
+        [&] { return rdwr(msgs.data(), messages.size()); }, retries);
+
+    timer.setRetries(retries);
+    turn.transferred(busBytes(messages.size(), dataBytes, retries));
+
+    // The data of the last message is traced, which is the data read when
+    // a write selects a register to read
+    const auto& last = messages.back();
+    trace(busId, devAddr, I2CTrace::Operation::transfer, 0, last.data,
+          (last.isRead && (ret < 0)) ? 0 : last.size, ret, retries);
+
+    if (ret < 0)
+    {
+        throw I2CException("Failed to transfer", busStr, devAddr, errno);
+    }
+}
+
 std::unique_ptr<I2CInterface> I2CDevice::create(uint8_t busId, uint8_t devAddr,
                                                 InitialState initialState,
                                                 int maxRetries)
@@ -1,6 +1,15 @@
 #pragma once
 
+#include "i2c_handle_pool.hpp"
 #include "i2c_interface.hpp"
+#include "i2c_retry_policy.hpp"
+#include "i2c_scheduler.hpp"
+
+#include <linux/i2c.h>
+
+#include <array>
+#include <cstdio>
+#include <memory>
 
 namespace i2c
 {
@@ -25,9 +34,14 @@ class I2CDevice : public I2CInterface
                        InitialState initialState = InitialState::OPEN,
                        int maxRetries = 0) :
         busId(busId),
-        devAddr(devAddr), maxRetries(maxRetries)
+        devAddr(devAddr), maxRetries(maxRetries),
+        bus(&BusScheduler::get().getBus(busId))
     {
+        retryPolicy = std::make_shared<BackoffRetryPolicy>(maxRetries);
         busStr = "/dev/i2c-" + std::to_string(busId);
+        char address[8];
+        std::snprintf(address, sizeof(address), ":0x%02x", devAddr);
+        statsName = busStr + address;
         if (initialState == InitialState::OPEN)
         {
             open();
@@ -49,14 +63,41 @@ class I2CDevice : public I2CInterface
     /** @brief Maximum number of times to retry an I2C operation */
     int maxRetries = 0;
 
+    /** @brief The bus in the scheduler, to take turns on */
+    BusScheduler::Bus* bus;
+
+    /** @brief Whether SMBus packet error checking is enabled */
+    bool pec = false;
+
+    /** @brief The shared handle of the opened i2c device */
+    std::shared_ptr<I2CHandle> handle;
+
     /** @brief The file descriptor of the opened i2c device */
     int fd = INVALID_FD;
 
     /** @brief The i2c bus path in /dev */
     std::string busStr;
 
-    /** @brief Cached I2C adapter functionality value */
-    unsigned long cachedFuncs = NO_FUNCS;
+    /** @brief The device name access statistics are recorded under */
+    std::string statsName;
+
+    /** @brief Decides how failed operations are retried */
+    std::shared_ptr<const RetryPolicy> retryPolicy;
+
+    /** @brief Tracks failed operations against the retry policy's budget */
+    CircuitBreaker breaker;
+
+    /** @brief Do an I2C operation, retrying it as the retry policy says
+     *
+     * @param[in] operation - Does the operation once, returning a negative
+     *                        value and setting errno on failure
+     * @param[out] retries - The number of times the operation was retried
+     *
+     * @throw I2CException if the device is parked
+     * @return The value returned by the last attempt
+     */
+    template <typename Operation>
+    int runWithRetries(Operation operation, int& retries);
 
     /** @brief Check that device interface is open
      *
@@ -70,6 +111,14 @@ class I2CDevice : public I2CInterface
         }
     }
 
+    /** @brief Wait for a turn on the bus
+     *
+     * @throw I2CThrottledException if the current thread's transactions are
+     *        Background ones and the bus is at its duty cycle limit
+     * @return The turn, which holds the bus until destroyed
+     */
+    BusScheduler::Turn takeTurn();
+
     /** @brief Close device without throwing an exception if an error occurs */
     void closeWithoutException() noexcept
     {
@@ -81,37 +130,92 @@ class I2CDevice : public I2CInterface
         {}
     }
 
+    /** @brief The transactions the adapter is checked for at open() */
+    enum Transaction : size_t
+    {
+        READ_BYTE,
+        READ_BYTE_DATA,
+        READ_WORD_DATA,
+        READ_BLOCK_DATA,
+        READ_I2C_BLOCK,
+        WRITE_BYTE,
+        WRITE_BYTE_DATA,
+        WRITE_WORD_DATA,
+        WRITE_BLOCK_DATA,
+        WRITE_I2C_BLOCK,
+        RDWR,
+        TRANSACTION_COUNT
+    };
+
+    /** @brief How the adapter does a transaction */
+    enum class Method : uint8_t
+    {
+        /** @brief Not supported */
+        MISSING,
+
+        /** @brief With the SMBus ioctl, or I2C_RDWR for RDWR */
+        NATIVE,
+
+        /** @brief With an I2C_RDWR transfer, since the SMBus block
+         *         transaction isn't supported */
+        TRANSFER
+    };
+
+    /** @brief How each transaction is done, resolved from the adapter
+     *         functionality when the device is opened */
+    std::array<Method, TRANSACTION_COUNT> methods{};
+
     /** @brief Get I2C adapter functionality
      *
-     * Caches the adapter functionality value since it shouldn't change after
-     * opening the device.
+     * Caches the adapter functionality value in the shared handle, since it
+     * shouldn't change after opening the device.
      *
      * @throw I2CException on error
      * @return Adapter functionality value
      */
     unsigned long getFuncs();
 
-    /** @brief Check i2c adapter read functionality
+    /** @brief Resolve how each transaction is done from the adapter
+     *         functionality
      *
-     * Check if the i2c adapter has the functionality specified by the SMBus
-     * transaction type
+     * @throw I2CException on error
+     */
+    void resolveMethods();
+
+    /** @brief Get how a transaction is done
      *
-     * @param[in] type - The SMBus transaction type defined in linux/i2c.h
+     * @param[in] transaction - The transaction
      *
-     * @throw I2CException if the function is not supported
+     * @throw I2CException if the adapter doesn't support it
+     * @return The method, never MISSING
      */
-    void checkReadFuncs(int type);
+    Method getMethod(Transaction transaction) const
+    {
+        Method method = methods[transaction];
+        if (method == Method::MISSING) [[unlikely]]
+        {
+            throwMissing(transaction);
+        }
+        return method;
+    }
 
-    /** @brief Check i2c adapter write functionality
+    /** @brief Throw the exception for a transaction the adapter doesn't
+     *         support
      *
-     * Check if the i2c adapter has the functionality specified by the SMBus
-     * transaction type
+     * @param[in] transaction - The transaction
+     *
+     * @throw I2CException always
+     */
+    [[noreturn]] void throwMissing(Transaction transaction) const;
+
+    /** @brief Do an I2C_RDWR transfer
      *
-     * @param[in] type - The SMBus transaction type defined in linux/i2c.h
+     * @param[in] msgs - The messages
+     * @param[in] count - The number of messages
      *
-     * @throw I2CException if the function is not supported
+     * @return The ioctl return value
      */
-    void checkWriteFuncs(int type);
+    int rdwr(i2c_msg* msgs, size_t count);
 
   public:
     /** @copydoc I2CInterface::~I2CInterface() */
@@ -149,6 +253,9 @@ class I2CDevice : public I2CInterface
     void read(uint8_t addr, uint8_t& size, uint8_t* data,
               Mode mode = Mode::SMBUS) override;
 
+    /** @copydoc I2CInterface::readRange() */
+    void readRange(uint8_t addr, std::span<uint8_t> data) override;
+
     /** @copydoc I2CInterface::write(uint8_t) */
     void write(uint8_t data) override;
 
@@ -162,6 +269,25 @@ class I2CDevice : public I2CInterface
     void write(uint8_t addr, uint8_t size, const uint8_t* data,
                Mode mode = Mode::SMBUS) override;
 
+    /** @copydoc I2CInterface::transfer() */
+    void transfer(std::span<const Message> messages) override;
+
+    /** @copydoc I2CInterface::canTransfer() */
+    bool canTransfer() const override
+    {
+        return isOpen() && !pec && (methods[RDWR] != Method::MISSING);
+    }
+
+    /** @copydoc I2CInterface::setPEC() */
+    void setPEC(bool enabled) override;
+
+    /** @copydoc I2CInterface::setRetryPolicy() */
+    void setRetryPolicy(std::shared_ptr<const RetryPolicy> policy) override
+    {
+        retryPolicy = std::move(policy);
+        breaker.success();
+    }
+
     /** @brief Create an I2CInterface instance
      *
      * Automatically opens the I2CInterface if initialState is OPEN.
@@ -0,0 +1,150 @@
+#include "i2c_handle_pool.hpp"
+
+#include "i2c_interface.hpp"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+extern "C"
+{
+#include <linux/i2c-dev.h>
+}
+
+namespace i2c
+{
+
+I2CHandle::~I2CHandle()
+{
+    ::close(fd);
+}
+
+I2CHandlePool& I2CHandlePool::get()
+{
+    static I2CHandlePool pool;
+    return pool;
+}
+
+std::shared_ptr<I2CHandle> I2CHandlePool::acquire(const std::string& busStr,
+                                                  uint8_t busId,
+                                                  uint8_t devAddr,
+                                                  bool pec, int maxRetries)
+{
+    std::lock_guard lock{mutex};
+    Key key{busId, devAddr, pec};
+
+    auto it = handles.find(key);
+    if (it != handles.end())
+    {
+        auto& handle = it->second;
+        if (handle.use_count() > 1)
+        {
+            stats.reused++;
+            return handle;
+        }
+
+        // Reuse an idle handle unless the adapter went away while it was
+        // idle: /dev/i2c-N must still be the same device, and the adapter
+        // behind the open file must still answer
+        struct stat st;
+        unsigned long funcs = 0;
+        if ((stat(busStr.c_str(), &st) == 0) && (st.st_rdev == handle->rdev) &&
+            (ioctl(handle->fd, I2C_FUNCS, &funcs) == 0))
+        {
+            handle->funcs = funcs;
+            stats.reused++;
+            return handle;
+        }
+
+        handles.erase(it);
+        stats.closed++;
+    }
+
+    int fd = -1, retries = 0;
+    do
+    {
+        fd = ::open(busStr.c_str(), O_RDWR);
+    } while ((fd == -1) && (++retries <= maxRetries));
+
+    if (fd == -1)
+    {
+        throw I2CException("Failed to open", busStr, devAddr, errno);
+    }
+
+    retries = 0;
+    int ret = 0;
+    do
+    {
+        ret = ioctl(fd, I2C_SLAVE, devAddr);
+    } while ((ret < 0) && (++retries <= maxRetries));
+
+    if (ret < 0)
+    {
+        int error = errno;
+
+        // Close device since setting slave address failed
+        ::close(fd);
+
+        throw I2CException("Failed to set I2C_SLAVE", busStr, devAddr, error);
+    }
+
+    if (pec)
+    {
+        retries = 0;
+        do
+        {
+            ret = ioctl(fd, I2C_PEC, 1);
+        } while ((ret < 0) && (++retries <= maxRetries));
+
+        if (ret < 0)
+        {
+            int error = errno;
+            ::close(fd);
+            throw I2CException("Failed to set I2C_PEC", busStr, devAddr,
+                               error);
+        }
+    }
+
+    struct stat st;
+    dev_t rdev = (fstat(fd, &st) == 0) ? st.st_rdev : 0;
+
+    auto handle = std::make_shared<I2CHandle>(fd, rdev);
+    handles.emplace(key, handle);
+    stats.opened++;
+
+    return handle;
+}
+
+void I2CHandlePool::closeIdle()
+{
+    std::lock_guard lock{mutex};
+    stats.closed += std::erase_if(handles, [](const auto& entry) {
+        return entry.second.use_count() == 1;
+    });
+}
+
+I2CHandlePool::Stats I2CHandlePool::getStats()
+{
+    std::lock_guard lock{mutex};
+    Stats current = stats;
+    current.open = handles.size();
+    current.idle = std::count_if(handles.begin(), handles.end(),
+                                 [](const auto& entry) {
+                                     return entry.second.use_count() == 1;
+                                 });
+    return current;
+}
+
+void I2CHandlePool::dump(std::ostream& out)
+{
+    auto current = getStats();
+    out << "i2c handles: open=" << current.open << " idle=" << current.idle
+        << " opened=" << current.opened << " reused=" << current.reused
+        << " closed=" << current.closed << "\n";
+}
+
+} // namespace i2c
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+namespace i2c
+{
+
+/** @brief An open /dev/i2c-N file with its device address set
+ *
+ * The file is closed when the last reference is dropped.
+ */
+class I2CHandle
+{
+  public:
+    I2CHandle() = delete;
+    I2CHandle(const I2CHandle&) = delete;
+    I2CHandle& operator=(const I2CHandle&) = delete;
+
+    /** @brief Constructor
+     *
+     * @param[in] fd - The open file descriptor, now owned by this object
+     * @param[in] rdev - The device number of the opened file
+     */
+    I2CHandle(int fd, dev_t rdev) : fd(fd), rdev(rdev) {}
+
+    ~I2CHandle();
+
+    /** @brief The file descriptor */
+    const int fd;
+
+    /** @brief The device number of the /dev/i2c-N file that was opened */
+    const dev_t rdev;
+
+    /** @brief Cached I2C adapter functionality value, 0 if not read yet */
+    std::atomic<unsigned long> funcs{0};
+};
+
+/** @brief Shares open I2C handles between the devices of a process
+ *
+ * Handles are keyed by bus, device address, and whether PEC is enabled,
+ * since the address and PEC are set per file.  Every I2CDevice opened for
+ * the same key uses the same file, and the file stays open after the last
+ * device closes, so reopening a device doesn't repeat the open() and
+ * I2C_SLAVE ioctl, and the functionality value doesn't have to be read
+ * again.
+ *
+ * An idle handle is only reused if /dev/i2c-N is still the same adapter,
+ * since the adapter can be removed and added again while it is idle.  Idle
+ * handles are closed by closeIdle(), which should be called when the
+ * devices are closed because the hardware may change, such as at power off.
+ */
+class I2CHandlePool
+{
+  public:
+    I2CHandlePool(const I2CHandlePool&) = delete;
+    I2CHandlePool& operator=(const I2CHandlePool&) = delete;
+
+    /** @brief Counts of how handles have been handed out */
+    struct Stats
+    {
+        /** @brief Handles opened */
+        size_t opened = 0;
+
+        /** @brief Requests given a handle that was already open */
+        size_t reused = 0;
+
+        /** @brief Handles closed */
+        size_t closed = 0;
+
+        /** @brief Handles open now */
+        size_t open = 0;
+
+        /** @brief Open handles no device is using */
+        size_t idle = 0;
+    };
+
+    /** @brief Gets the process-wide pool
+     *
+     * @return The pool
+     */
+    static I2CHandlePool& get();
+
+    /** @brief Gets an open handle to a device
+     *
+     * @param[in] busStr - The i2c bus path in /dev
+     * @param[in] busId - The i2c bus ID
+     * @param[in] devAddr - The device address
+     * @param[in] pec - Whether to enable SMBus packet error checking
+     * @param[in] maxRetries - Maximum number of times to retry opening
+     *
+     * @throw I2CException if the device could not be opened
+     * @return The handle, which stays open while referenced
+     */
+    std::shared_ptr<I2CHandle> acquire(const std::string& busStr,
+                                       uint8_t busId, uint8_t devAddr,
+                                       bool pec, int maxRetries);
+
+    /** @brief Closes the handles no device is using */
+    void closeIdle();
+
+    /** @brief Gets the handle counts
+     *
+     * @return The counts
+     */
+    Stats getStats();
+
+    /** @brief Writes the handle counts as one line of text
+     *
+     * @param[in] out - The stream to write to
+     */
+    void dump(std::ostream& out);
+
+  private:
+    I2CHandlePool() = default;
+
+    using Key = std::tuple<uint8_t, uint8_t, bool>;
+
+    std::mutex mutex;
+    std::map<Key, std::shared_ptr<I2CHandle>> handles;
+    Stats stats;
+};
+
+} // namespace i2c
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "i2c_retry_policy.hpp"
+
+#include <cerrno>
 #include <cstdint>
 #include <cstring>
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -36,12 +40,37 @@ class I2CException : public std::exception
     {
         return errStr.c_str();
     }
+
+    /** @brief Check whether the error is a packet error checking failure,
+     *         meaning the data was corrupted on the bus
+     *
+     * @return true if the PEC byte didn't match the data
+     */
+    bool isPECError() const noexcept
+    {
+        return errorCode == EBADMSG;
+    }
+
     std::string bus;
     uint8_t addr;
     int errorCode;
     std::string errStr;
 };
 
+/** @brief Thrown instead of doing a Background transaction on a bus that is
+ *         at its duty cycle limit
+ *
+ * Nothing was sent to the device, so the caller can skip the operation and
+ * try it again later.
+ */
+class I2CThrottledException : public I2CException
+{
+  public:
+    I2CThrottledException(const std::string& bus, uint8_t addr) :
+        I2CException("Bus at its duty cycle limit", bus, addr, EBUSY)
+    {}
+};
+
 class I2CInterface
 {
   public:
@@ -65,6 +94,42 @@ class I2CInterface
         I2C,
     };
 
+    /** @brief One message of a combined transaction.  See transfer(). */
+    struct Message
+    {
+        /** @brief Create a message that writes to the device
+         *
+         * @param[in] data - The bytes to write
+         * @param[in] size - The number of bytes
+         */
+        static Message write(const uint8_t* data, uint16_t size)
+        {
+            return {false, const_cast<uint8_t*>(data), size};
+        }
+
+        /** @brief Create a message that reads from the device
+         *
+         * @param[out] data - The buffer to read into
+         * @param[in] size - The number of bytes
+         */
+        static Message read(uint8_t* data, uint16_t size)
+        {
+            return {true, data, size};
+        }
+
+        /** @brief Whether the message reads, else it writes */
+        bool isRead;
+
+        /** @brief The bytes to write, or the buffer to read into */
+        uint8_t* data;
+
+        /** @brief The number of bytes */
+        uint16_t size;
+    };
+
+    /** @brief The most messages one transfer() can do; the I2C_RDWR limit */
+    static constexpr size_t maxMessages = 42;
+
     /** @brief Open the I2C interface to the device
      *
      * Throws an I2CException if the interface is already open.  See isOpen().
@@ -141,6 +206,22 @@ class I2CInterface
     virtual void read(uint8_t addr, uint8_t& size, uint8_t* data,
                       Mode mode = Mode::SMBUS) = 0;
 
+    /** @brief Read a range of consecutive registers
+     *
+     * For devices that step to the next register after each byte read, like
+     * EEPROMs and most register files.  The range is read in I2C block reads
+     * of up to 32 bytes, each starting at the register after the last byte
+     * of the one before, straight into the buffer.  Other transactions can
+     * run between the block reads, so a long capture doesn't hold the bus.
+     *
+     * @param[in] addr - The register address of the first byte
+     * @param[out] data - The buffer to fill; its size is the number of
+     *                    registers to read, up to the last register, 0xFF
+     *
+     * @throw I2CException on error
+     */
+    virtual void readRange(uint8_t addr, std::span<uint8_t> data) = 0;
+
     /** @brief Write byte data to i2c
      *
      * @param[in] data - The data to write to the i2c device
@@ -185,6 +266,55 @@ class I2CInterface
      */
     virtual void write(uint8_t addr, uint8_t size, const uint8_t* data,
                        Mode mode = Mode::SMBUS) = 0;
+
+    /** @brief Do several reads and writes as one combined transaction
+     *
+     * The messages are sent with repeated starts between them and a single
+     * stop at the end, so no other transaction can get onto the bus in
+     * between.  For example, writing a command code and then reading two
+     * bytes is a word read, and several word reads can be done at once.
+     *
+     * Internally, it uses the I2C_RDWR ioctl, so it needs an adapter that
+     * supports plain I2C transactions.
+     *
+     * @param[in,out] messages - The messages, up to maxMessages.  The
+     *                           buffers of read messages are filled in.
+     *
+     * @throw I2CException on error
+     */
+    virtual void transfer(std::span<const Message> messages) = 0;
+
+    /** @brief Check whether transfer() can be used in place of SMBus
+     *         transactions
+     *
+     * It can't if the adapter doesn't support plain I2C transactions, or if
+     * PEC is enabled, since the messages of a transfer() have no PEC byte.
+     *
+     * @return true if the interface is open and transfer() can be used
+     */
+    virtual bool canTransfer() const = 0;
+
+    /** @brief Set how failed operations are retried
+     *
+     * The default policy retries up to maxRetries times with exponential
+     * backoff and never parks the device.
+     *
+     * @param[in] policy - The retry policy
+     */
+    virtual void setRetryPolicy(std::shared_ptr<const RetryPolicy> policy) = 0;
+
+    /** @brief Enable or disable SMBus packet error checking
+     *
+     * With PEC, a CRC-8 byte is added to each SMBus transaction, and a
+     * transaction whose data doesn't match it fails with an I2CException
+     * for which isPECError() is true.  PEC doesn't apply to I2C mode block
+     * transactions or transfer().  If the interface is open it is reopened.
+     *
+     * @param[in] enabled - Whether to use PEC
+     *
+     * @throw I2CException on error, like the adapter not supporting PEC
+     */
+    virtual void setPEC(bool enabled) = 0;
 };
 
 /** @brief Create an I2CInterface instance
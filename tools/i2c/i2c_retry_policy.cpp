@@ -0,0 +1,81 @@
+#include "i2c_retry_policy.hpp"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace i2c
+{
+
+std::optional<std::chrono::microseconds>
+    BackoffRetryPolicy::retryDelay(int retries, int error) const
+{
+    if ((retries >= maxRetries) || (error == ENODEV))
+    {
+        return std::nullopt;
+    }
+
+    // Double the delay for each retry, without overflowing the shift
+    auto delay = initialDelay;
+    for (int i = 0; (i < retries) && (delay < maxDelay); i++)
+    {
+        delay *= 2;
+    }
+    return std::min(delay, maxDelay);
+}
+
+std::chrono::milliseconds BackoffRetryPolicy::parkTime(int trips) const
+{
+    auto time = firstParkTime;
+    for (int i = 1; (i < trips) && (time < maxParkTime); i++)
+    {
+        time *= 2;
+    }
+    return std::min(time, maxParkTime);
+}
+
+bool CircuitBreaker::allow(const RetryPolicy& policy, Clock::time_point now)
+{
+    if (policy.failureBudget() <= 0)
+    {
+        return true;
+    }
+
+    // Once the park time is up, operations are let through until one fails
+    return !isParked(now);
+}
+
+void CircuitBreaker::success()
+{
+    failures = 0;
+    trips = 0;
+}
+
+void CircuitBreaker::failure(const RetryPolicy& policy, Clock::time_point now)
+{
+    failures++;
+
+    int budget = policy.failureBudget();
+    if (budget <= 0)
+    {
+        return;
+    }
+
+    // A failure after being parked parks the device again right away
+    if ((trips > 0) || (failures >= budget))
+    {
+        trips++;
+        parkedUntil = now + policy.parkTime(trips);
+    }
+}
+
+std::chrono::milliseconds
+    CircuitBreaker::getParkTimeLeft(Clock::time_point now) const
+{
+    if (!isParked(now))
+    {
+        return std::chrono::milliseconds{0};
+    }
+    return std::chrono::ceil<std::chrono::milliseconds>(parkedUntil - now);
+}
+
+} // namespace i2c
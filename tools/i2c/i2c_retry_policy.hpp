@@ -0,0 +1,186 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace i2c
+{
+
+/** @brief Decides how failed I2C operations of a device are retried
+ *
+ * The policy also sets the device's error budget: after that many
+ * operations in a row fail, even with retries, the device is parked for a
+ * while and its operations fail right away without using the bus.
+ */
+class RetryPolicy
+{
+  public:
+    virtual ~RetryPolicy() = default;
+
+    /** @brief Get the delay before retrying a failed operation
+     *
+     * @param[in] retries - The number of times the operation was retried
+     * @param[in] error - The errno value of the last attempt
+     *
+     * @return The delay, or nothing to give up
+     */
+    virtual std::optional<std::chrono::microseconds>
+        retryDelay(int retries, int error) const = 0;
+
+    /** @brief Get the number of failed operations in a row that park the
+     *         device; 0 never parks it
+     *
+     * @return The error budget
+     */
+    virtual int failureBudget() const = 0;
+
+    /** @brief Get how long the device is parked for
+     *
+     * @param[in] trips - The number of times the device was parked without
+     *                    a successful operation since, including this one
+     *
+     * @return The park time
+     */
+    virtual std::chrono::milliseconds parkTime(int trips) const = 0;
+};
+
+/** @brief A retry policy with exponential backoff
+ *
+ * Retries are delayed by initialDelay, then twice that, and so on up to
+ * maxDelay.  The park time also doubles each time the device is parked
+ * again, up to maxParkTime.  ENODEV isn't retried since the adapter is
+ * gone.
+ */
+class BackoffRetryPolicy : public RetryPolicy
+{
+  public:
+    /** @brief Constructor
+     *
+     * @param[in] maxRetries - Maximum number of times to retry an operation
+     * @param[in] initialDelay - The delay before the first retry
+     * @param[in] maxDelay - The longest delay before a retry
+     * @param[in] failureBudget - Failed operations in a row that park the
+     *                            device; 0 never parks it
+     * @param[in] parkTime - How long the device is first parked for
+     * @param[in] maxParkTime - The longest the device is parked for
+     */
+    explicit BackoffRetryPolicy(
+        int maxRetries,
+        std::chrono::microseconds initialDelay = defaultInitialDelay,
+        std::chrono::microseconds maxDelay = defaultMaxDelay,
+        int failureBudget = 0,
+        std::chrono::milliseconds parkTime = defaultParkTime,
+        std::chrono::milliseconds maxParkTime = defaultMaxParkTime) :
+        maxRetries(maxRetries),
+        initialDelay(initialDelay), maxDelay(maxDelay), budget(failureBudget),
+        firstParkTime(parkTime), maxParkTime(maxParkTime)
+    {}
+
+    /** @brief The default delay before the first retry */
+    static constexpr std::chrono::microseconds defaultInitialDelay{500};
+
+    /** @brief The default longest delay before a retry */
+    static constexpr std::chrono::microseconds defaultMaxDelay{8000};
+
+    /** @brief The default time a device is first parked for */
+    static constexpr std::chrono::milliseconds defaultParkTime{5000};
+
+    /** @brief The default longest time a device is parked for */
+    static constexpr std::chrono::milliseconds defaultMaxParkTime{60000};
+
+    /** @copydoc RetryPolicy::retryDelay() */
+    std::optional<std::chrono::microseconds>
+        retryDelay(int retries, int error) const override;
+
+    /** @copydoc RetryPolicy::failureBudget() */
+    int failureBudget() const override
+    {
+        return budget;
+    }
+
+    /** @copydoc RetryPolicy::parkTime() */
+    std::chrono::milliseconds parkTime(int trips) const override;
+
+  private:
+    int maxRetries;
+    std::chrono::microseconds initialDelay;
+    std::chrono::microseconds maxDelay;
+    int budget;
+    std::chrono::milliseconds firstParkTime;
+    std::chrono::milliseconds maxParkTime;
+};
+
+/** @brief Tracks the failed operations of a device against the error budget
+ *         of its retry policy
+ *
+ * The breaker is closed while operations are allowed, and open while the
+ * device is parked.  When the park time is up one operation is let through;
+ * if it works the breaker closes, otherwise the device is parked again for
+ * longer.
+ */
+class CircuitBreaker
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Check whether an operation may be done
+     *
+     * @param[in] policy - The retry policy of the device
+     * @param[in] now - The current time
+     *
+     * @return true if the device isn't parked
+     */
+    bool allow(const RetryPolicy& policy, Clock::time_point now = Clock::now());
+
+    /** @brief Record an operation that worked */
+    void success();
+
+    /** @brief Record an operation that failed after its retries
+     *
+     * @param[in] policy - The retry policy of the device
+     * @param[in] now - The current time
+     */
+    void failure(const RetryPolicy& policy,
+                 Clock::time_point now = Clock::now());
+
+    /** @brief Check whether the device is parked
+     *
+     * @param[in] now - The current time
+     *
+     * @return true if parked
+     */
+    bool isParked(Clock::time_point now = Clock::now()) const
+    {
+        return (trips > 0) && (now < parkedUntil);
+    }
+
+    /** @brief Get the number of operations in a row that failed
+     *
+     * @return The failure count
+     */
+    int getFailures() const
+    {
+        return failures;
+    }
+
+    /** @brief Get the time left until the device is unparked
+     *
+     * @param[in] now - The current time
+     *
+     * @return The time left, 0 if not parked
+     */
+    std::chrono::milliseconds
+        getParkTimeLeft(Clock::time_point now = Clock::now()) const;
+
+  private:
+    /** @brief Failed operations in a row */
+    int failures = 0;
+
+    /** @brief Times parked since the last operation that worked */
+    int trips = 0;
+
+    /** @brief When the current park time is up */
+    Clock::time_point parkedUntil;
+};
+
+} // namespace i2c
@@ -0,0 +1,169 @@
+#include "i2c_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace i2c
+{
+
+BusScheduler& BusScheduler::get()
+{
+    static BusScheduler scheduler;
+    return scheduler;
+}
+
+BusScheduler::Bus& BusScheduler::getBus(uint8_t bus)
+{
+    std::lock_guard lock{mutex};
+    return buses[bus];
+}
+
+bool BusScheduler::admit(Bus& state)
+{
+    if (PriorityScope::current() != Priority::Background)
+    {
+        return true;
+    }
+
+    std::lock_guard lock{state.mutex};
+    if (state.dutyCycleLimit >= 1.0)
+    {
+        return true;
+    }
+
+    // Refuse while the bus has been held for its duty cycle limit, until
+    // enough old turns leave the window
+    expireTurns(state, Clock::now());
+    auto allowed = std::chrono::duration_cast<std::chrono::microseconds>(
+        state.dutyCycleWindow * state.dutyCycleLimit);
+    if (state.recentHeld < allowed)
+    {
+        return true;
+    }
+
+    state.stats.throttled++;
+    return false;
+}
+
+BusScheduler::Turn BusScheduler::acquire(Bus& state)
+{
+    std::unique_lock lock{state.mutex};
+
+    if (!state.busy && state.waiters.empty())
+    {
+        state.busy = true;
+        return Turn{state};
+    }
+
+    auto waiter = std::make_pair(PriorityScope::current(), state.nextTicket++);
+    state.waiters.insert(waiter);
+    state.released.wait(lock, [&state, &waiter] {
+        return !state.busy && (*state.waiters.begin() == waiter);
+    });
+    state.waiters.erase(waiter);
+    state.busy = true;
+
+    return Turn{state};
+}
+
+void BusScheduler::release(Bus& state, Clock::time_point start, size_t bytes)
+{
+    std::lock_guard lock{state.mutex};
+    state.busy = false;
+
+    auto now = Clock::now();
+    auto held = std::chrono::duration_cast<std::chrono::microseconds>(now -
+                                                                      start);
+    state.stats.heldTime += held;
+    if (bytes > 0)
+    {
+        // Each byte is 8 data bits and an acknowledge bit
+        state.stats.transactions++;
+        state.stats.bytes += bytes;
+        state.stats.wireTime +=
+            std::chrono::microseconds{bytes * 9 * 1000000 / state.clockRate};
+    }
+
+    state.recentTurns.push_back({now, held});
+    state.recentHeld += held;
+    expireTurns(state, now);
+
+    // Each waiter checks whether it is the one to go next
+    state.released.notify_all();
+}
+
+void BusScheduler::setClockRate(uint8_t bus, uint32_t hz)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    state.clockRate = std::max(hz, uint32_t{1});
+}
+
+void BusScheduler::setDutyCycleLimit(uint8_t bus, double limit,
+                                     std::chrono::milliseconds window)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    state.dutyCycleLimit = std::clamp(limit, 0.01, 1.0);
+    state.dutyCycleWindow = std::max(window, std::chrono::milliseconds{1});
+}
+
+BusScheduler::BusStats BusScheduler::getStats(uint8_t bus)
+{
+    return getStats(getBus(bus));
+}
+
+BusScheduler::BusStats BusScheduler::getStats(Bus& state)
+{
+    std::lock_guard lock{state.mutex};
+    expireTurns(state, Clock::now());
+
+    auto stats = state.stats;
+    stats.utilization = static_cast<double>(state.recentHeld.count()) /
+                        state.dutyCycleWindow.count();
+    return stats;
+}
+
+void BusScheduler::dump(std::ostream& out)
+{
+    std::vector<std::pair<uint8_t, Bus*>> states;
+    {
+        std::lock_guard lock{mutex};
+        for (auto& [bus, state] : buses)
+        {
+            states.emplace_back(bus, &state);
+        }
+    }
+
+    for (auto [bus, state] : states)
+    {
+        auto stats = getStats(*state);
+        out << "i2c bus " << static_cast<int>(bus)
+            << ": transactions=" << stats.transactions
+            << " bytes=" << stats.bytes
+            << " held_us=" << stats.heldTime.count()
+            << " wire_us=" << stats.wireTime.count()
+            << " throttled=" << stats.throttled
+            << " utilization=" << stats.utilization << "\n";
+    }
+}
+
+void BusScheduler::expireTurns(Bus& state, Clock::time_point now)
+{
+    while (!state.recentTurns.empty() &&
+           (state.recentTurns.front().end + state.dutyCycleWindow <= now))
+    {
+        state.recentHeld -= state.recentTurns.front().held;
+        state.recentTurns.pop_front();
+    }
+}
+
+size_t BusScheduler::waiting(uint8_t bus)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    return state.waiters.size();
+}
+
+} // namespace i2c
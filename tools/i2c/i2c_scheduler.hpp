@@ -0,0 +1,340 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <utility>
+
+namespace i2c
+{
+
+/** @brief The priority of the I2C transactions issued by a thread
+ *
+ * Transactions waiting for the same bus are done in priority order, and in
+ * the order they started waiting within a priority.
+ */
+enum class Priority
+{
+    /** @brief Everything not marked otherwise */
+    Normal = 0,
+
+    /** @brief Periodic reads, like sensor monitoring */
+    Background = 1,
+};
+
+/** @brief Sets the priority of the current thread's I2C transactions
+ *
+ * The previous priority is restored when the object is destroyed.
+ */
+class PriorityScope
+{
+  public:
+    PriorityScope() = delete;
+    PriorityScope(const PriorityScope&) = delete;
+    PriorityScope& operator=(const PriorityScope&) = delete;
+
+    /** @brief Constructor
+     *
+     * @param[in] priority - The priority to use until destroyed
+     */
+    explicit PriorityScope(Priority priority) : previous(currentPriority)
+    {
+        currentPriority = priority;
+    }
+
+    ~PriorityScope()
+    {
+        currentPriority = previous;
+    }
+
+    /** @brief Gets the priority of the current thread's transactions
+     *
+     * @return The priority
+     */
+    static Priority current()
+    {
+        return currentPriority;
+    }
+
+  private:
+    /** @brief The priority of the current thread's transactions */
+    static inline thread_local Priority currentPriority = Priority::Normal;
+
+    Priority previous;
+};
+
+/** @brief Orders the I2C transactions of a process by bus
+ *
+ * Only one transaction is done on a bus at a time.  When several threads
+ * want the same bus the highest priority one gets it next, so other
+ * transactions aren't stuck behind background sensor reads.
+ *
+ * Each bus has its own lock, and devices look their bus up once with
+ * getBus(), so transactions on different buses don't contend and a
+ * transaction doesn't search for its bus.
+ *
+ * The scheduler also keeps account of each bus: the transactions and bytes
+ * done, the time the bus was held, and the time the bytes take on the wire
+ * at the bus clock rate.  A bus can have a duty cycle limit, the fraction
+ * of a window it may be held for; once it is reached, Background turns
+ * aren't admitted until the bus has been used less, so periodic reads can't
+ * crowd out a firmware update or fault analysis on a busy bus.  They are
+ * refused rather than delayed, since a periodic read can be skipped, and
+ * waiting would hold up the thread, often the one running the event loop.
+ */
+class BusScheduler
+{
+  public:
+    BusScheduler(const BusScheduler&) = delete;
+    BusScheduler& operator=(const BusScheduler&) = delete;
+
+    class Bus;
+
+    /** @brief The standard mode bus clock rate, used if not set */
+    static constexpr uint32_t defaultClockRate = 100000;
+
+    /** @brief The duty cycle window used if not set */
+    static constexpr std::chrono::milliseconds defaultDutyCycleWindow{1000};
+
+    /** @brief The use of a bus since the process started */
+    struct BusStats
+    {
+        /** @brief Turns in which bytes were transferred */
+        size_t transactions = 0;
+
+        /** @brief Bytes transferred, including addresses and command codes */
+        size_t bytes = 0;
+
+        /** @brief Time the bus was held by turns */
+        std::chrono::microseconds heldTime{0};
+
+        /** @brief Time the bytes take on the wire at the bus clock rate */
+        std::chrono::microseconds wireTime{0};
+
+        /** @brief Background turns refused because of the duty cycle limit */
+        size_t throttled = 0;
+
+        /** @brief Fraction of the duty cycle window the bus was held for,
+         *         over the last window */
+        double utilization = 0.0;
+    };
+
+    /** @brief Exclusive use of a bus, until destroyed */
+    class Turn
+    {
+      public:
+        Turn(const Turn&) = delete;
+        Turn& operator=(const Turn&) = delete;
+        Turn(Turn&& other) noexcept :
+            bus(std::exchange(other.bus, nullptr)), start(other.start),
+            bytes(other.bytes)
+        {}
+        Turn& operator=(Turn&&) = delete;
+
+        ~Turn()
+        {
+            if (bus != nullptr)
+            {
+                release(*bus, start, bytes);
+            }
+        }
+
+        /** @brief Counts bytes transferred on the bus during the turn
+         *
+         * @param[in] count - The number of bytes, including the address
+         *                    and command code bytes
+         */
+        void transferred(size_t count)
+        {
+            bytes += count;
+        }
+
+      private:
+        friend class BusScheduler;
+
+        explicit Turn(Bus& bus) :
+            bus(&bus), start(std::chrono::steady_clock::now())
+        {}
+
+        Bus* bus;
+        std::chrono::steady_clock::time_point start;
+        size_t bytes = 0;
+    };
+
+    /** @brief Gets the process-wide scheduler
+     *
+     * @return The scheduler
+     */
+    static BusScheduler& get();
+
+    /** @brief Gets the state of a bus, creating it on first use
+     *
+     * The reference stays valid for the life of the process.
+     *
+     * @param[in] bus - The i2c bus ID
+     *
+     * @return The bus
+     */
+    Bus& getBus(uint8_t bus);
+
+    /** @brief Checks whether the current thread may take a turn on the bus
+     *
+     * Background turns aren't admitted while the bus is at its duty cycle
+     * limit.  Other priorities always are.
+     *
+     * @param[in] bus - The bus, from getBus()
+     *
+     * @return false if the turn should be skipped
+     */
+    static bool admit(Bus& bus);
+
+    /** @brief Waits for the bus, at the current thread's priority
+     *
+     * @param[in] bus - The bus, from getBus()
+     *
+     * @return The turn, which holds the bus until destroyed
+     */
+    static Turn acquire(Bus& bus);
+
+    /** @brief Waits for the bus, at the current thread's priority
+     *
+     * @param[in] bus - The i2c bus ID
+     *
+     * @return The turn, which holds the bus until destroyed
+     */
+    Turn acquire(uint8_t bus)
+    {
+        return acquire(getBus(bus));
+    }
+
+    /** @brief Sets the clock rate of a bus, for the wire time estimate
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] hz - The clock rate in Hz
+     */
+    void setClockRate(uint8_t bus, uint32_t hz);
+
+    /** @brief Sets the fraction of time a bus may be busy before Background
+     *         turns are refused
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] limit - The fraction of the window, above 0; 1, the
+     *                    default, turns the limit off
+     * @param[in] window - The time the fraction is measured over
+     */
+    void setDutyCycleLimit(
+        uint8_t bus, double limit,
+        std::chrono::milliseconds window = defaultDutyCycleWindow);
+
+    /** @brief Gets the use of a bus
+     *
+     * @param[in] bus - The i2c bus ID
+     *
+     * @return The counts and times
+     */
+    BusStats getStats(uint8_t bus);
+
+    /** @brief Writes the use of each bus, one line per bus
+     *
+     * @param[in] out - The stream to write to
+     */
+    void dump(std::ostream& out);
+
+    /** @brief Gets the number of threads waiting for a bus
+     *
+     * @param[in] bus - The i2c bus ID
+     *
+     * @return The waiter count
+     */
+    size_t waiting(uint8_t bus);
+
+    /** @brief The state of a bus, only used by the scheduler */
+    class Bus
+    {
+      public:
+        Bus() = default;
+        Bus(const Bus&) = delete;
+        Bus& operator=(const Bus&) = delete;
+
+      private:
+        friend class BusScheduler;
+
+        using Clock = std::chrono::steady_clock;
+
+        /** @brief A turn that ended: when, and how long the bus was held */
+        struct HeldTime
+        {
+            Clock::time_point end;
+            std::chrono::microseconds held;
+        };
+
+        /** @brief Protects the rest of the bus state */
+        std::mutex mutex;
+
+        /** @brief Whether a thread has a turn on the bus */
+        bool busy = false;
+
+        /** @brief The waiting threads, by priority and then arrival */
+        std::set<std::pair<Priority, uint64_t>> waiters;
+
+        /** @brief The arrival number of the next waiter */
+        uint64_t nextTicket = 0;
+
+        /** @brief Signaled when the bus is released */
+        std::condition_variable released;
+
+        uint32_t clockRate = defaultClockRate;
+        double dutyCycleLimit = 1.0;
+        std::chrono::microseconds dutyCycleWindow{defaultDutyCycleWindow};
+
+        /** @brief The turns that ended within the duty cycle window */
+        std::deque<HeldTime> recentTurns;
+
+        /** @brief The total time of recentTurns */
+        std::chrono::microseconds recentHeld{0};
+
+        BusStats stats;
+    };
+
+  private:
+    BusScheduler() = default;
+
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Releases a bus, called when a Turn is destroyed
+     *
+     * @param[in] state - The bus
+     * @param[in] start - When the turn started
+     * @param[in] bytes - The bytes transferred during the turn
+     */
+    static void release(Bus& state, Clock::time_point start, size_t bytes);
+
+    /** @brief Gets the use of a bus
+     *
+     * @param[in] state - The bus
+     *
+     * @return The counts and times
+     */
+    static BusStats getStats(Bus& state);
+
+    /** @brief Drops the turns that ended before the duty cycle window
+     *
+     * @param[in] state - The bus, which must be locked
+     * @param[in] now - The current time
+     */
+    static void expireTurns(Bus& state, Clock::time_point now);
+
+    /** @brief Protects buses.  Bus states are never removed, so a reference
+     *         to one can be used without it. */
+    std::mutex mutex;
+
+    std::map<uint8_t, Bus> buses;
+};
+
+} // namespace i2c
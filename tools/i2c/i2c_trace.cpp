@@ -0,0 +1,212 @@
+#include "i2c_trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace i2c
+{
+
+namespace
+{
+
+/**
+ * The name of each I2CTrace::Operation
+ */
+constexpr std::array<const char*, 11> operationNames{
+    "read byte",
+    "read byte data",
+    "read word data",
+    "read block data",
+    "read i2c block data",
+    "write byte",
+    "write byte data",
+    "write word data",
+    "write block data",
+    "write i2c block data",
+    "transfer"};
+
+/**
+ * Packs the fields of a record other than the timestamp and data into one
+ * word.
+ */
+uint64_t packFields(const I2CTrace::Record& record)
+{
+    return uint64_t{record.bus} | (uint64_t{record.address} << 8) |
+           (uint64_t{record.command} << 16) |
+           (uint64_t{static_cast<uint8_t>(record.operation)} << 24) |
+           (uint64_t{record.size} << 32) | (uint64_t{record.retries} << 40) |
+           (uint64_t{static_cast<uint16_t>(record.result)} << 48);
+}
+
+/**
+ * Unpacks the fields packed by packFields().
+ */
+void unpackFields(uint64_t word, I2CTrace::Record& record)
+{
+    record.bus = static_cast<uint8_t>(word);
+    record.address = static_cast<uint8_t>(word >> 8);
+    record.command = static_cast<uint8_t>(word >> 16);
+    record.operation = static_cast<I2CTrace::Operation>(
+        static_cast<uint8_t>(word >> 24));
+    record.size = static_cast<uint8_t>(word >> 32);
+    record.retries = static_cast<uint8_t>(word >> 40);
+    record.result = static_cast<int16_t>(static_cast<uint16_t>(word >> 48));
+}
+
+} // namespace
+
+I2CTrace& I2CTrace::get()
+{
+    static I2CTrace trace;
+    return trace;
+}
+
+void I2CTrace::record(Record record)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+
+    uint64_t data = 0;
+    std::memcpy(&data, record.data.data(), sizeof(data));
+
+    // Mark the slot as being written before changing it, so a reader
+    // copying the record it held sees that its copy may be torn
+    uint64_t number = next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[number % capacity];
+    slot.sequence.store(2 * number + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.words[0].store(record.timestamp.count(), std::memory_order_relaxed);
+    slot.words[1].store(packFields(record), std::memory_order_relaxed);
+    slot.words[2].store(data, std::memory_order_relaxed);
+
+    slot.sequence.store(2 * (number + 1), std::memory_order_release);
+}
+
+std::vector<I2CTrace::Record> I2CTrace::getRecords(size_t count) const
+{
+    uint64_t end = next.load(std::memory_order_acquire);
+    uint64_t begin = first.load(std::memory_order_relaxed);
+    count = std::min(count, capacity);
+    if (end - std::min(begin, end) > count)
+    {
+        begin = end - count;
+    }
+
+    std::vector<Record> records;
+    records.reserve(end - std::min(begin, end));
+    for (uint64_t number = begin; number < end; number++)
+    {
+        const Slot& slot = slots[number % capacity];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * (number + 1))
+        {
+            // Still being written, or already overwritten
+            continue;
+        }
+
+        uint64_t timestamp = slot.words[0].load(std::memory_order_relaxed);
+        uint64_t fields = slot.words[1].load(std::memory_order_relaxed);
+        uint64_t data = slot.words[2].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+
+        Record& record = records.emplace_back();
+        record.timestamp = std::chrono::nanoseconds{timestamp};
+        unpackFields(fields, record);
+        std::memcpy(record.data.data(), &data, sizeof(data));
+    }
+
+    return records;
+}
+
+std::vector<std::string> I2CTrace::format(size_t count) const
+{
+    std::vector<std::string> lines;
+    for (const auto& record : getRecords(count))
+    {
+        // Like "1234.567890 i2c-3 0x70 read word data 0x8B: 0C 00", followed
+        // by the retries and error if there are any
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                          record.timestamp)
+                          .count();
+        auto operation = static_cast<size_t>(record.operation);
+        std::array<char, 128> buffer;
+        int length = std::snprintf(
+            buffer.data(), buffer.size(), "%lld.%06lld i2c-%u 0x%02X %s",
+            static_cast<long long>(micros / 1000000),
+            static_cast<long long>(micros % 1000000), record.bus,
+            record.address,
+            (operation < operationNames.size()) ? operationNames[operation]
+                                                 : "unknown");
+        std::string line{buffer.data(),
+                         static_cast<size_t>(std::max(length, 0))};
+
+        if ((record.operation != Operation::readByte) &&
+            (record.operation != Operation::writeByte) &&
+            (record.operation != Operation::transfer))
+        {
+            std::snprintf(buffer.data(), buffer.size(), " 0x%02X",
+                          record.command);
+            line += buffer.data();
+        }
+
+        if (record.size > 0)
+        {
+            line += ':';
+            size_t shown = std::min(size_t{record.size}, dataBytes);
+            for (size_t i = 0; i < shown; i++)
+            {
+                std::snprintf(buffer.data(), buffer.size(), " %02X",
+                              record.data[i]);
+                line += buffer.data();
+            }
+            if (record.size > shown)
+            {
+                line += " ... (" + std::to_string(record.size) + " bytes)";
+            }
+        }
+
+        if (record.retries > 0)
+        {
+            line += ", retries " + std::to_string(record.retries);
+        }
+
+        if (record.result < 0)
+        {
+            line += ", error " + std::to_string(-record.result) + " (" +
+                    std::strerror(-record.result) + ")";
+        }
+
+        lines.emplace_back(std::move(line));
+    }
+
+    return lines;
+}
+
+void I2CTrace::dump(std::ostream& out) const
+{
+    out << "I2C trace:\n";
+    for (const auto& line : format())
+    {
+        out << line << '\n';
+    }
+}
+
+void I2CTrace::clear()
+{
+    first.store(next.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+}
+
+} // namespace i2c
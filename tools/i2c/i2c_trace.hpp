@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace i2c
+{
+
+/** @brief Keeps the last I2C transactions of a process
+ *
+ * Every I2CDevice records its transactions in one fixed-size ring, so the
+ * transactions that led up to a failure can be added to its error log
+ * without turning on kernel i2c tracing.
+ *
+ * Recording doesn't take a lock or allocate: a record is claimed with an
+ * atomic increment and written into its slot, and the slot's sequence
+ * number tells readers whether the record was changed while they copied
+ * it.  A record that is being written or was overwritten while being read
+ * is left out of the copy.
+ *
+ * Nothing is recorded until enable() is called, so programs that don't
+ * report the trace don't pay for it.
+ */
+class I2CTrace
+{
+  public:
+    I2CTrace(const I2CTrace&) = delete;
+    I2CTrace& operator=(const I2CTrace&) = delete;
+
+    /** @brief The number of transactions kept */
+    static constexpr size_t capacity = 256;
+
+    /** @brief The number of data bytes kept per transaction */
+    static constexpr size_t dataBytes = 8;
+
+    /** @brief The kinds of transactions */
+    enum class Operation : uint8_t
+    {
+        readByte,
+        readByteData,
+        readWordData,
+        readBlockData,
+        readI2CBlockData,
+        writeByte,
+        writeByteData,
+        writeWordData,
+        writeBlockData,
+        writeI2CBlockData,
+        transfer
+    };
+
+    /** @brief One transaction */
+    struct Record
+    {
+        /** @brief When the transaction ended, on the monotonic clock */
+        std::chrono::nanoseconds timestamp{0};
+
+        /** @brief The i2c bus ID */
+        uint8_t bus = 0;
+
+        /** @brief The device address */
+        uint8_t address = 0;
+
+        /** @brief The command code; 0 if the transaction has none */
+        uint8_t command = 0;
+
+        /** @brief The kind of transaction */
+        Operation operation = Operation::readByte;
+
+        /** @brief The number of data bytes read or written */
+        uint8_t size = 0;
+
+        /** @brief The number of times the transaction was retried */
+        uint8_t retries = 0;
+
+        /** @brief 0 if the transaction worked, or the negative errno value
+         *         it failed with */
+        int16_t result = 0;
+
+        /** @brief The first data bytes read or written */
+        std::array<uint8_t, dataBytes> data{};
+    };
+
+    /** @brief Gets the process-wide trace
+     *
+     * @return The trace
+     */
+    static I2CTrace& get();
+
+    /** @brief Starts recording transactions */
+    void enable()
+    {
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /** @brief Returns whether transactions are being recorded */
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Records a transaction, if recording is enabled
+     *
+     * @param[in] record - The transaction; its timestamp is set to the
+     *                     current time
+     */
+    void record(Record record);
+
+    /** @brief Gets the last transactions recorded, oldest first
+     *
+     * @param[in] count - The most transactions to get
+     *
+     * @return The transactions
+     */
+    std::vector<Record> getRecords(size_t count = capacity) const;
+
+    /** @brief Formats the last transactions recorded as lines of text,
+     *         oldest first
+     *
+     * @param[in] count - The most transactions to format
+     *
+     * @return The lines, with no newlines
+     */
+    std::vector<std::string> format(size_t count = capacity) const;
+
+    /** @brief Writes all the transactions kept as lines of text
+     *
+     * @param[in] out - The stream to write to
+     */
+    void dump(std::ostream& out) const;
+
+    /** @brief Forgets the transactions recorded so far */
+    void clear();
+
+  private:
+    I2CTrace() = default;
+
+    /** @brief Where a record is kept, packed into atomic words */
+    struct Slot
+    {
+        /** @brief Odd while the record is being written, then
+         *         2 * (record number + 1) */
+        std::atomic<uint64_t> sequence{0};
+
+        std::array<std::atomic<uint64_t>, 3> words{};
+    };
+
+    std::atomic<bool> enabled{false};
+
+    /** @brief The number of the next record */
+    std::atomic<uint64_t> next{0};
+
+    /** @brief The number of the first record not cleared */
+    std::atomic<uint64_t> first{0};
+
+    std::array<Slot, capacity> slots;
+};
+
+} // namespace i2c
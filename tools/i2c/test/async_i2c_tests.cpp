@@ -0,0 +1,167 @@
+#include "async_engine.hpp"
+#include "async_i2c.hpp"
+#include "simulated_i2c.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace i2c;
+using namespace std::chrono_literals;
+using phosphor::power::util::AsyncEngine;
+
+class AsyncI2CTests : public ::testing::Test
+{
+  protected:
+    AsyncI2CTests()
+    {
+        SimulatedI2C::Device device;
+        device.registers[0x20] = {0x17};
+        device.registers[0x8B] = {0x00, 0x0C};
+        simulation->addDevice(3, 0x70, device);
+        simulation->addDevice(3, 0x71, device);
+        simulation->addDevice(4, 0x70, device);
+    }
+
+    /** @brief Runs the event loop until the condition is true, or 5 seconds
+     *         pass
+     *
+     * @param[in] condition - The condition to wait for
+     *
+     * @return The condition
+     */
+    bool runUntil(const std::function<bool()>& condition)
+    {
+        auto end = std::chrono::steady_clock::now() + 5s;
+        while (!condition() && (std::chrono::steady_clock::now() < end))
+        {
+            event.run(10ms);
+        }
+        return condition();
+    }
+
+    sdeventplus::Event event = sdeventplus::Event::get_default();
+    std::shared_ptr<SimulatedI2C> simulation = SimulatedI2C::create();
+};
+
+TEST_F(AsyncI2CTests, ReadWrite)
+{
+    AsyncEngine engine{event, 2};
+    AsyncI2C device{engine, simulation->createInterface(3, 0x70), 3};
+    auto loopThread = std::this_thread::get_id();
+
+    // Operations on a bus run in order, so the read sees the write
+    bool written = false;
+    device.writeWord(0x21, 0x1234, [&written](std::exception_ptr error) {
+        EXPECT_EQ(error, nullptr);
+        written = true;
+    });
+
+    uint16_t word = 0;
+    device.readWord(0x21, [&word, loopThread](std::exception_ptr error,
+                                              uint16_t data) {
+        EXPECT_EQ(error, nullptr);
+        EXPECT_EQ(std::this_thread::get_id(), loopThread);
+        word = data;
+    });
+
+    std::vector<uint8_t> block;
+    device.read(0x8B, 2, I2CInterface::Mode::I2C,
+                [&block](std::exception_ptr error, std::vector<uint8_t> data) {
+                    EXPECT_EQ(error, nullptr);
+                    block = std::move(data);
+                });
+
+    EXPECT_TRUE(runUntil([&] { return engine.pending() == 0; }));
+    EXPECT_TRUE(written);
+    EXPECT_EQ(word, 0x1234);
+    EXPECT_EQ(block, (std::vector<uint8_t>{0x00, 0x0C}));
+}
+
+TEST_F(AsyncI2CTests, Error)
+{
+    AsyncEngine engine{event, 1};
+    AsyncI2C device{engine, simulation->createInterface(3, 0x70), 3};
+
+    bool done = false;
+    device.read(0x99, [&done](std::exception_ptr error, uint8_t data) {
+        ASSERT_NE(error, nullptr);
+        try
+        {
+            std::rethrow_exception(error);
+        }
+        catch (const I2CException& e)
+        {
+            EXPECT_EQ(e.errorCode, ENXIO);
+        }
+        EXPECT_EQ(data, 0);
+        done = true;
+    });
+
+    EXPECT_TRUE(runUntil([&done] { return done; }));
+}
+
+TEST_F(AsyncI2CTests, Buses)
+{
+    SimulatedI2C::Device slow;
+    slow.registers[0x20] = {0x17};
+    slow.latency = 200ms;
+    simulation->addDevice(3, 0x70, slow);
+    simulation->addDevice(3, 0x71, slow);
+    simulation->addDevice(4, 0x70, slow);
+
+    AsyncEngine engine{event, 4};
+    AsyncI2C device1{engine, simulation->createInterface(3, 0x70), 3};
+    AsyncI2C device2{engine, simulation->createInterface(3, 0x71), 3};
+    AsyncI2C device3{engine, simulation->createInterface(4, 0x70), 4};
+
+    std::vector<int> order;
+    auto append = [&order](int id) {
+        return [&order, id](std::exception_ptr error, uint8_t) {
+            EXPECT_EQ(error, nullptr);
+            order.push_back(id);
+        };
+    };
+
+    // The devices on bus 3 take turns, while bus 4 runs at the same time
+    auto start = std::chrono::steady_clock::now();
+    device1.read(0x20, append(1));
+    device2.read(0x20, append(2));
+    device3.read(0x20, append(3));
+
+    EXPECT_TRUE(runUntil([&order] { return order.size() == 3; }));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, 400ms);
+    EXPECT_LT(elapsed, 550ms);
+    EXPECT_EQ(order.back(), 2);
+}
+
+TEST_F(AsyncI2CTests, Lifetime)
+{
+    AsyncEngine engine{event, 1};
+
+    // The interface stays alive until the operation is done
+    bool done = false;
+    {
+        AsyncI2C device{engine, simulation->createInterface(3, 0x70), 3};
+        device.run(
+            [](I2CInterface& i2c) {
+                uint8_t data = 0;
+                i2c.read(0x20, data);
+                EXPECT_EQ(data, 0x17);
+            },
+            [&done](std::exception_ptr error) {
+                EXPECT_EQ(error, nullptr);
+                done = true;
+            });
+    }
+
+    EXPECT_TRUE(runUntil([&done] { return done; }));
+}
@@ -0,0 +1,75 @@
+#include "i2c_handle_pool.hpp"
+#include "i2c_interface.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace i2c;
+
+TEST(I2CHandleTests, ClosesFile)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ::close(fds[1]);
+
+    {
+        I2CHandle handle{fds[0], 0};
+        EXPECT_EQ(handle.fd, fds[0]);
+        EXPECT_EQ(handle.funcs, 0);
+    }
+
+    errno = 0;
+    EXPECT_EQ(fcntl(fds[0], F_GETFD), -1);
+    EXPECT_EQ(errno, EBADF);
+}
+
+TEST(I2CHandlePoolTests, OpenFails)
+{
+    auto& pool = I2CHandlePool::get();
+    auto before = pool.getStats();
+
+    try
+    {
+        pool.acquire("/dev/i2c-does-not-exist", 250, 0x70, false, 2);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_EQ(e.errorCode, ENOENT);
+        EXPECT_NE(std::string{e.what()}.find("Failed to open"),
+                  std::string::npos);
+    }
+
+    auto after = pool.getStats();
+    EXPECT_EQ(after.opened, before.opened);
+    EXPECT_EQ(after.open, before.open);
+}
+
+TEST(I2CHandlePoolTests, SetAddressFails)
+{
+    auto& pool = I2CHandlePool::get();
+    auto before = pool.getStats();
+
+    // The I2C_SLAVE ioctl fails on a file that isn't an I2C adapter
+    try
+    {
+        pool.acquire("/dev/null", 251, 0x70, true, 0);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_NE(std::string{e.what()}.find("Failed to set I2C_SLAVE"),
+                  std::string::npos);
+    }
+
+    pool.closeIdle();
+    auto after = pool.getStats();
+    EXPECT_EQ(after.opened, before.opened);
+    EXPECT_EQ(after.open, 0);
+    EXPECT_EQ(after.idle, 0);
+}
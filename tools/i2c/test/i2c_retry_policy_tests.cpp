@@ -0,0 +1,92 @@
+#include "i2c_retry_policy.hpp"
+
+#include <cerrno>
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace i2c;
+using namespace std::chrono_literals;
+
+TEST(BackoffRetryPolicyTests, RetryDelay)
+{
+    BackoffRetryPolicy policy{4, 1000us, 3000us};
+
+    EXPECT_EQ(policy.retryDelay(0, EIO), 1000us);
+    EXPECT_EQ(policy.retryDelay(1, EIO), 2000us);
+    EXPECT_EQ(policy.retryDelay(2, EIO), 3000us);
+    EXPECT_EQ(policy.retryDelay(3, EIO), 3000us);
+    EXPECT_EQ(policy.retryDelay(4, EIO), std::nullopt);
+
+    // The adapter is gone, so retrying won't help
+    EXPECT_EQ(policy.retryDelay(0, ENODEV), std::nullopt);
+
+    BackoffRetryPolicy noRetries{0};
+    EXPECT_EQ(noRetries.retryDelay(0, EIO), std::nullopt);
+}
+
+TEST(BackoffRetryPolicyTests, ParkTime)
+{
+    BackoffRetryPolicy policy{3, 0us, 0us, 2, 100ms, 350ms};
+
+    EXPECT_EQ(policy.failureBudget(), 2);
+    EXPECT_EQ(policy.parkTime(1), 100ms);
+    EXPECT_EQ(policy.parkTime(2), 200ms);
+    EXPECT_EQ(policy.parkTime(3), 350ms);
+    EXPECT_EQ(policy.parkTime(30), 350ms);
+}
+
+TEST(CircuitBreakerTests, NoBudget)
+{
+    BackoffRetryPolicy policy{3};
+    CircuitBreaker breaker;
+    auto now = CircuitBreaker::Clock::now();
+
+    for (int i = 0; i < 100; i++)
+    {
+        breaker.failure(policy, now);
+    }
+    EXPECT_TRUE(breaker.allow(policy, now));
+    EXPECT_FALSE(breaker.isParked(now));
+    EXPECT_EQ(breaker.getFailures(), 100);
+}
+
+TEST(CircuitBreakerTests, Park)
+{
+    BackoffRetryPolicy policy{0, 0us, 0us, 3, 100ms, 1000ms};
+    CircuitBreaker breaker;
+    auto now = CircuitBreaker::Clock::now();
+
+    // Failures under the budget don't park the device
+    breaker.failure(policy, now);
+    breaker.failure(policy, now);
+    EXPECT_TRUE(breaker.allow(policy, now));
+
+    // A success resets the count
+    breaker.success();
+    breaker.failure(policy, now);
+    breaker.failure(policy, now);
+    EXPECT_TRUE(breaker.allow(policy, now));
+    EXPECT_EQ(breaker.getFailures(), 2);
+
+    breaker.failure(policy, now);
+    EXPECT_FALSE(breaker.allow(policy, now));
+    EXPECT_TRUE(breaker.isParked(now + 99ms));
+    EXPECT_EQ(breaker.getParkTimeLeft(now + 40ms), 60ms);
+
+    // When the park time is up an operation is let through; if it fails the
+    // device is parked again for twice as long
+    now += 100ms;
+    EXPECT_TRUE(breaker.allow(policy, now));
+    EXPECT_EQ(breaker.getParkTimeLeft(now), 0ms);
+    breaker.failure(policy, now);
+    EXPECT_FALSE(breaker.allow(policy, now + 199ms));
+
+    // If it works the device isn't parked anymore
+    now += 200ms;
+    EXPECT_TRUE(breaker.allow(policy, now));
+    breaker.success();
+    EXPECT_EQ(breaker.getFailures(), 0);
+    breaker.failure(policy, now);
+    EXPECT_TRUE(breaker.allow(policy, now));
+}
@@ -0,0 +1,163 @@
+#include "i2c_scheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace i2c;
+using namespace std::chrono_literals;
+
+TEST(PriorityScopeTests, Nesting)
+{
+    EXPECT_EQ(PriorityScope::current(), Priority::Normal);
+    {
+        PriorityScope background{Priority::Background};
+        EXPECT_EQ(PriorityScope::current(), Priority::Background);
+        {
+            PriorityScope normal{Priority::Normal};
+            EXPECT_EQ(PriorityScope::current(), Priority::Normal);
+        }
+        EXPECT_EQ(PriorityScope::current(), Priority::Background);
+    }
+    EXPECT_EQ(PriorityScope::current(), Priority::Normal);
+}
+
+TEST(BusSchedulerTests, Priority)
+{
+    auto& scheduler = BusScheduler::get();
+    constexpr uint8_t bus = 1;
+
+    std::mutex mutex;
+    std::vector<Priority> order;
+
+    std::vector<std::thread> threads;
+    {
+        // Hold the bus until all the threads are waiting for it
+        auto turn = scheduler.acquire(bus);
+
+        for (auto priority :
+             {Priority::Background, Priority::Background, Priority::Normal})
+        {
+            auto waiting = scheduler.waiting(bus);
+            threads.emplace_back([&, priority] {
+                PriorityScope scope{priority};
+                auto turn = scheduler.acquire(bus);
+                std::lock_guard lock{mutex};
+                order.push_back(priority);
+            });
+
+            // Start them in this order, so priority and arrival differ
+            auto end = std::chrono::steady_clock::now() + 5s;
+            while ((scheduler.waiting(bus) == waiting) &&
+                   (std::chrono::steady_clock::now() < end))
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+        }
+        EXPECT_EQ(scheduler.waiting(bus), 3);
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(order,
+              (std::vector<Priority>{Priority::Normal, Priority::Background,
+                                     Priority::Background}));
+    EXPECT_EQ(scheduler.waiting(bus), 0);
+}
+
+TEST(BusSchedulerTests, Accounting)
+{
+    auto& scheduler = BusScheduler::get();
+    constexpr uint8_t bus = 5;
+    scheduler.setClockRate(bus, 400000);
+
+    {
+        auto turn = scheduler.acquire(bus);
+        turn.transferred(5);
+        std::this_thread::sleep_for(10ms);
+    }
+    {
+        // A turn without a transaction
+        auto turn = scheduler.acquire(bus);
+    }
+
+    auto stats = scheduler.getStats(bus);
+    EXPECT_EQ(stats.transactions, 1);
+    EXPECT_EQ(stats.bytes, 5);
+    EXPECT_GE(stats.heldTime, 10ms);
+    EXPECT_EQ(stats.wireTime, 112us);
+    EXPECT_EQ(stats.throttled, 0);
+    EXPECT_GT(stats.utilization, 0.0);
+
+    std::ostringstream out;
+    scheduler.dump(out);
+    EXPECT_NE(out.str().find("i2c bus 5: transactions=1 bytes=5 "),
+              std::string::npos);
+}
+
+TEST(BusSchedulerTests, DutyCycleLimit)
+{
+    auto& scheduler = BusScheduler::get();
+    constexpr uint8_t bus = 6;
+    scheduler.setDutyCycleLimit(bus, 0.25, 200ms);
+
+    // Hold the bus for more than a quarter of the window
+    {
+        auto turn = scheduler.acquire(bus);
+        std::this_thread::sleep_for(60ms);
+    }
+
+    // Other priorities aren't limited
+    auto& state = scheduler.getBus(bus);
+    EXPECT_TRUE(BusScheduler::admit(state));
+    {
+        PriorityScope scope{Priority::Normal};
+        EXPECT_TRUE(BusScheduler::admit(state));
+    }
+    EXPECT_EQ(scheduler.getStats(bus).throttled, 0);
+
+    // Background is refused, without waiting, until the turn leaves the
+    // window
+    {
+        PriorityScope scope{Priority::Background};
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(BusScheduler::admit(state));
+        EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+        EXPECT_EQ(scheduler.getStats(bus).throttled, 1);
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_TRUE(BusScheduler::admit(state));
+    }
+    EXPECT_EQ(scheduler.getStats(bus).throttled, 1);
+
+    scheduler.setDutyCycleLimit(bus, 1.0);
+}
+
+TEST(BusSchedulerTests, GetBus)
+{
+    auto& scheduler = BusScheduler::get();
+    constexpr uint8_t bus = 7;
+
+    // A bus is only created once, and its turns are counted like those
+    // acquired by bus ID
+    auto& state = scheduler.getBus(bus);
+    EXPECT_EQ(&scheduler.getBus(bus), &state);
+    {
+        auto turn = BusScheduler::acquire(state);
+        turn.transferred(2);
+    }
+    {
+        auto turn = scheduler.acquire(bus);
+        turn.transferred(3);
+    }
+    EXPECT_EQ(scheduler.getStats(bus).bytes, 5);
+}
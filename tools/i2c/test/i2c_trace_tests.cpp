@@ -0,0 +1,177 @@
+#include "i2c_trace.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace i2c;
+
+namespace
+{
+
+I2CTrace::Record makeRecord(uint8_t bus, uint8_t command, uint8_t value)
+{
+    I2CTrace::Record record;
+    record.bus = bus;
+    record.address = 0x70;
+    record.command = command;
+    record.operation = I2CTrace::Operation::readWordData;
+    record.size = 2;
+    record.data = {value, static_cast<uint8_t>(value + 1)};
+    return record;
+}
+
+} // namespace
+
+// Runs first, before any test enables the trace
+TEST(I2CTraceTests, Disabled)
+{
+    auto& trace = I2CTrace::get();
+    EXPECT_FALSE(trace.isEnabled());
+
+    trace.record(makeRecord(3, 0x8B, 0x0C));
+    EXPECT_TRUE(trace.getRecords().empty());
+}
+
+TEST(I2CTraceTests, Record)
+{
+    auto& trace = I2CTrace::get();
+    trace.enable();
+    trace.clear();
+
+    auto failed = makeRecord(4, 0x20, 0);
+    failed.operation = I2CTrace::Operation::readByteData;
+    failed.size = 0;
+    failed.retries = 2;
+    failed.result = -ENXIO;
+
+    trace.record(makeRecord(3, 0x8B, 0x0C));
+    trace.record(failed);
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].bus, 3);
+    EXPECT_EQ(records[0].address, 0x70);
+    EXPECT_EQ(records[0].command, 0x8B);
+    EXPECT_EQ(records[0].operation, I2CTrace::Operation::readWordData);
+    EXPECT_EQ(records[0].size, 2);
+    EXPECT_EQ(records[0].retries, 0);
+    EXPECT_EQ(records[0].result, 0);
+    EXPECT_EQ(records[0].data[0], 0x0C);
+    EXPECT_EQ(records[0].data[1], 0x0D);
+    EXPECT_GT(records[0].timestamp.count(), 0);
+    EXPECT_EQ(records[1].bus, 4);
+    EXPECT_EQ(records[1].retries, 2);
+    EXPECT_EQ(records[1].result, -ENXIO);
+    EXPECT_GE(records[1].timestamp, records[0].timestamp);
+
+    // Only the last records
+    records = trace.getRecords(1);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].bus, 4);
+
+    trace.clear();
+    EXPECT_TRUE(trace.getRecords().empty());
+}
+
+TEST(I2CTraceTests, Format)
+{
+    auto& trace = I2CTrace::get();
+    trace.enable();
+    trace.clear();
+
+    auto write = makeRecord(3, 0, 0);
+    write.operation = I2CTrace::Operation::writeBlockData;
+    write.command = 0x21;
+    write.size = 10;
+    write.data = {0, 1, 2, 3, 4, 5, 6, 7};
+    write.retries = 1;
+    write.result = -EIO;
+
+    trace.record(makeRecord(3, 0x8B, 0x0C));
+    trace.record(write);
+
+    auto lines = trace.format();
+    ASSERT_EQ(lines.size(), 2);
+
+    // The lines start with the time, which isn't known
+    auto first = lines[0].substr(lines[0].find(' ') + 1);
+    EXPECT_EQ(first, "i2c-3 0x70 read word data 0x8B: 0C 0D");
+    auto second = lines[1].substr(lines[1].find(' ') + 1);
+    EXPECT_EQ(second, "i2c-3 0x70 write block data 0x21: 00 01 02 03 04 05 06 "
+                      "07 ... (10 bytes), retries 1, error 5 (" +
+                          std::string{strerror(EIO)} + ")");
+
+    std::ostringstream out;
+    trace.dump(out);
+    EXPECT_EQ(out.str(), "I2C trace:\n" + lines[0] + '\n' + lines[1] + '\n');
+}
+
+TEST(I2CTraceTests, Wraps)
+{
+    auto& trace = I2CTrace::get();
+    trace.enable();
+    trace.clear();
+
+    // Only the last records fit
+    for (size_t i = 0; i < I2CTrace::capacity + 10; i++)
+    {
+        trace.record(makeRecord(3, static_cast<uint8_t>(i), 0));
+    }
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(records.size(), I2CTrace::capacity);
+    EXPECT_EQ(records.front().command, 10);
+    EXPECT_EQ(records.back().command,
+              static_cast<uint8_t>(I2CTrace::capacity + 9));
+}
+
+TEST(I2CTraceTests, Concurrent)
+{
+    auto& trace = I2CTrace::get();
+    trace.enable();
+    trace.clear();
+
+    // Records written from several threads while being read are never torn:
+    // each one's data matches its command
+    std::atomic<int> running{4};
+    std::vector<std::thread> writers;
+    for (uint8_t bus = 0; bus < 4; bus++)
+    {
+        writers.emplace_back([&trace, &running, bus] {
+            for (size_t i = 0; i < 100000; i++)
+            {
+                auto value = static_cast<uint8_t>(i);
+                trace.record(makeRecord(bus, value, value));
+            }
+            running--;
+        });
+    }
+
+    size_t read = 0;
+    while (running > 0)
+    {
+        for (const auto& record : trace.getRecords())
+        {
+            EXPECT_LT(record.bus, 4);
+            EXPECT_EQ(record.data[0], record.command);
+            EXPECT_EQ(record.data[1], static_cast<uint8_t>(record.command + 1));
+            read++;
+        }
+    }
+
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+
+    EXPECT_GT(read, 0);
+    EXPECT_EQ(trace.getRecords().size(), I2CTrace::capacity);
+}
@@ -22,6 +22,8 @@ class MockedI2CInterface : public I2CInterface
     MOCK_METHOD(void, read,
                 (uint8_t addr, uint8_t& size, uint8_t* data, Mode mode),
                 (override));
+    MOCK_METHOD(void, readRange, (uint8_t addr, std::span<uint8_t> data),
+                (override));
 
     MOCK_METHOD(void, write, (uint8_t data), (override));
     MOCK_METHOD(void, write, (uint8_t addr, uint8_t data), (override));
@@ -29,6 +31,13 @@ class MockedI2CInterface : public I2CInterface
     MOCK_METHOD(void, write,
                 (uint8_t addr, uint8_t size, const uint8_t* data, Mode mode),
                 (override));
+
+    MOCK_METHOD(bool, canTransfer, (), (const, override));
+    MOCK_METHOD(void, transfer, (std::span<const Message> messages),
+                (override));
+    MOCK_METHOD(void, setRetryPolicy,
+                (std::shared_ptr<const RetryPolicy> policy), (override));
+    MOCK_METHOD(void, setPEC, (bool enabled), (override));
 };
 
 } // namespace i2c
@@ -0,0 +1,602 @@
+#include "simulated_i2c.hpp"
+
+#include <linux/i2c.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace i2c
+{
+
+using json = nlohmann::json;
+
+namespace
+{
+
+/**
+ * Parses a number that is a JSON number or a hex string like "0x8B".
+ */
+unsigned long parseNumber(const json& element, unsigned long max)
+{
+    unsigned long value = 0;
+    if (element.is_number_integer() && (element.get<long long>() >= 0))
+    {
+        value = element.get<unsigned long>();
+    }
+    else if (element.is_string())
+    {
+        const auto& text = element.get_ref<const std::string&>();
+        size_t end = 0;
+        try
+        {
+            value = std::stoul(text, &end, 0);
+        }
+        catch (const std::exception&)
+        {
+            end = 0;
+        }
+        if ((end == 0) || (end != text.size()))
+        {
+            throw std::invalid_argument{"Invalid number: " + text};
+        }
+    }
+    else
+    {
+        throw std::invalid_argument{"Invalid number: " + element.dump()};
+    }
+
+    if (value > max)
+    {
+        throw std::invalid_argument{"Number out of range: " + element.dump()};
+    }
+    return value;
+}
+
+uint8_t parseByte(const json& element)
+{
+    return static_cast<uint8_t>(parseNumber(element, UINT8_MAX));
+}
+
+SimulatedI2C::Device parseDevice(const json& element)
+{
+    SimulatedI2C::Device device;
+
+    if (element.contains("latency_us"))
+    {
+        device.latency = std::chrono::microseconds{
+            parseNumber(element["latency_us"], UINT32_MAX)};
+    }
+
+    device.nack = element.value("nack", false);
+
+    if (element.contains("registers"))
+    {
+        for (const auto& [command, value] : element["registers"].items())
+        {
+            std::vector<uint8_t> bytes;
+            for (const auto& byte : value)
+            {
+                bytes.push_back(parseByte(byte));
+            }
+            device.registers[parseByte(command)] = std::move(bytes);
+        }
+    }
+
+    if (element.contains("faults"))
+    {
+        for (const auto& faultElement : element["faults"])
+        {
+            SimulatedI2C::Fault fault;
+            if (faultElement.contains("command"))
+            {
+                fault.command = parseByte(faultElement["command"]);
+            }
+            if (faultElement.contains("every"))
+            {
+                fault.every = std::max(
+                    parseNumber(faultElement["every"], UINT32_MAX), 1UL);
+            }
+            if (faultElement.contains("count"))
+            {
+                fault.count = parseNumber(faultElement["count"], UINT32_MAX);
+            }
+            if (faultElement.contains("errno"))
+            {
+                fault.error = parseNumber(faultElement["errno"], INT32_MAX);
+            }
+            device.faults.push_back(fault);
+        }
+    }
+
+    return device;
+}
+
+/**
+ * An I2CInterface to a simulated device.  Behaves like an I2CDevice: it has
+ * to be opened, failed operations are retried as the retry policy says,
+ * and errors are thrown as I2CExceptions with the same messages.
+ */
+class SimulatedI2CInterface : public I2CInterface
+{
+  public:
+    SimulatedI2CInterface(std::shared_ptr<SimulatedI2C> simulation,
+                          uint8_t busId, uint8_t devAddr, int maxRetries) :
+        simulation(std::move(simulation)),
+        busId(busId), devAddr(devAddr),
+        busStr("/dev/i2c-" + std::to_string(busId)),
+        retryPolicy(std::make_shared<BackoffRetryPolicy>(maxRetries))
+    {}
+
+    void open() override
+    {
+        if (opened)
+        {
+            throw I2CException("Device already open", busStr, devAddr);
+        }
+        opened = true;
+    }
+
+    bool isOpen() const override
+    {
+        return opened;
+    }
+
+    void close() override
+    {
+        checkIsOpen();
+        opened = false;
+    }
+
+    void read(uint8_t& data) override
+    {
+        run(std::nullopt, 1, "Failed to read byte",
+            [&data](SimulatedI2C::Device& device) {
+                return readRegister(device, device.pointer, &data, 1);
+            });
+    }
+
+    void read(uint8_t addr, uint8_t& data) override
+    {
+        run(addr, 2, "Failed to read byte data",
+            [addr, &data](SimulatedI2C::Device& device) {
+                return readRegister(device, addr, &data, 1);
+            });
+    }
+
+    void read(uint8_t addr, uint16_t& data) override
+    {
+        run(addr, 3, "Failed to read word data",
+            [addr, &data](SimulatedI2C::Device& device) {
+                uint8_t bytes[2]{};
+                int error = readRegister(device, addr, bytes, 2);
+                data = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+                return error;
+            });
+    }
+
+    void read(uint8_t addr, uint8_t& size, uint8_t* data,
+              Mode mode = Mode::SMBUS) override
+    {
+        if (mode == Mode::SMBUS)
+        {
+            uint8_t count = 0;
+            run(addr, 2 + I2C_SMBUS_BLOCK_MAX, "Failed to read block data",
+                [addr, data, &count](SimulatedI2C::Device& device) {
+                    auto it = device.registers.find(addr);
+                    if (it == device.registers.end())
+                    {
+                        return ENXIO;
+                    }
+                    count = std::min(it->second.size(),
+                                     size_t{I2C_SMBUS_BLOCK_MAX});
+                    std::copy_n(it->second.begin(), count, data);
+                    return 0;
+                });
+            size = count;
+        }
+        else
+        {
+            run(addr, 1 + size, "Failed to read block data",
+                [addr, size, data](SimulatedI2C::Device& device) {
+                    return readRegister(device, addr, data, size);
+                });
+        }
+    }
+
+    void readRange(uint8_t addr, std::span<uint8_t> data) override
+    {
+        if (data.size() > size_t{UINT8_MAX} + 1 - addr)
+        {
+            checkIsOpen();
+            throw I2CException("Invalid register range", busStr, devAddr,
+                               EINVAL);
+        }
+
+        size_t offset = 0;
+        while (offset < data.size())
+        {
+            auto size = static_cast<uint8_t>(std::min(
+                data.size() - offset, size_t{I2C_SMBUS_BLOCK_MAX}));
+            read(static_cast<uint8_t>(addr + offset), size, &data[offset],
+                 Mode::I2C);
+            offset += size;
+        }
+    }
+
+    void write(uint8_t data) override
+    {
+        run(std::nullopt, 1, "Failed to write byte",
+            [data](SimulatedI2C::Device& device) {
+                device.pointer = data;
+                return 0;
+            });
+    }
+
+    void write(uint8_t addr, uint8_t data) override
+    {
+        writeRegister(addr, {data}, "Failed to write byte data");
+    }
+
+    void write(uint8_t addr, uint16_t data) override
+    {
+        writeRegister(addr,
+                      {static_cast<uint8_t>(data),
+                       static_cast<uint8_t>(data >> 8)},
+                      "Failed to write word data");
+    }
+
+    void write(uint8_t addr, uint8_t size, const uint8_t* data,
+               Mode /*mode*/ = Mode::SMBUS) override
+    {
+        writeRegister(addr, std::vector<uint8_t>(data, data + size),
+                      "Failed to write block data");
+    }
+
+    void transfer(std::span<const Message> messages) override
+    {
+        if (messages.empty() || (messages.size() > maxMessages))
+        {
+            checkIsOpen();
+            throw I2CException("Invalid message count", busStr, devAddr,
+                               EINVAL);
+        }
+
+        size_t bytes = 0;
+        for (const auto& message : messages)
+        {
+            bytes += 1 + message.size;
+        }
+
+        std::optional<uint8_t> command;
+        if (!messages[0].isRead && (messages[0].size > 0))
+        {
+            command = messages[0].data[0];
+        }
+
+        // A write selects the register, and any more bytes in it are written
+        // to the register; a read gets the selected register
+        run(command, bytes, "Failed to transfer", false,
+            [messages](SimulatedI2C::Device& device) {
+                for (const auto& message : messages)
+                {
+                    if (message.isRead)
+                    {
+                        int error = readRegister(device, device.pointer,
+                                                 message.data, message.size);
+                        if (error != 0)
+                        {
+                            return error;
+                        }
+                    }
+                    else if (message.size > 0)
+                    {
+                        device.pointer = message.data[0];
+                        if (message.size > 1)
+                        {
+                            device.registers[device.pointer].assign(
+                                message.data + 1, message.data + message.size);
+                        }
+                    }
+                }
+                return 0;
+            });
+    }
+
+    bool canTransfer() const override
+    {
+        return isOpen() && !pec;
+    }
+
+    void setRetryPolicy(std::shared_ptr<const RetryPolicy> policy) override
+    {
+        retryPolicy = std::move(policy);
+    }
+
+    void setPEC(bool enabled) override
+    {
+        pec = enabled;
+    }
+
+  private:
+    /**
+     * Copies a register value, padded with 0xFF like a device that has no
+     * more data.  Fails with ENXIO if the register isn't in the map.
+     */
+    static int readRegister(SimulatedI2C::Device& device, uint8_t command,
+                            uint8_t* data, size_t size)
+    {
+        auto it = device.registers.find(command);
+        if (it == device.registers.end())
+        {
+            return ENXIO;
+        }
+
+        const auto& value = it->second;
+        for (size_t i = 0; i < size; i++)
+        {
+            data[i] = (i < value.size()) ? value[i] : 0xFF;
+        }
+        return 0;
+    }
+
+    void writeRegister(uint8_t addr, std::vector<uint8_t> value,
+                       const char* failure)
+    {
+        run(addr, 2 + value.size(), failure,
+            [addr, &value](SimulatedI2C::Device& device) {
+                device.registers[addr] = value;
+                return 0;
+            });
+    }
+
+    void checkIsOpen() const
+    {
+        if (!opened)
+        {
+            throw I2CException("Device not open", busStr, devAddr);
+        }
+    }
+
+    /**
+     * Does a transaction, retrying it as the retry policy says.  SMBus
+     * transactions take a byte longer with PEC.
+     */
+    void run(std::optional<uint8_t> command, size_t bytes, const char* failure,
+             const SimulatedI2C::Action& action)
+    {
+        run(command, bytes, failure, true, action);
+    }
+
+    void run(std::optional<uint8_t> command, size_t bytes, const char* failure,
+             bool smbus, const SimulatedI2C::Action& action)
+    {
+        checkIsOpen();
+
+        if (smbus && pec)
+        {
+            bytes++;
+        }
+
+        int retries = 0;
+        int error = simulation->transact(busId, devAddr, command, bytes,
+                                         action);
+        while (error != 0)
+        {
+            auto delay = retryPolicy->retryDelay(retries, error);
+            if (!delay)
+            {
+                throw I2CException(failure, busStr, devAddr, error);
+            }
+            std::this_thread::sleep_for(*delay);
+            retries++;
+            error = simulation->transact(busId, devAddr, command, bytes,
+                                         action);
+        }
+    }
+
+    std::shared_ptr<SimulatedI2C> simulation;
+    uint8_t busId;
+    uint8_t devAddr;
+    std::string busStr;
+    std::shared_ptr<const RetryPolicy> retryPolicy;
+    bool opened = false;
+    bool pec = false;
+};
+
+} // namespace
+
+std::shared_ptr<SimulatedI2C> SimulatedI2C::create()
+{
+    return std::shared_ptr<SimulatedI2C>{new SimulatedI2C};
+}
+
+std::shared_ptr<SimulatedI2C> SimulatedI2C::create(const json& element)
+{
+    auto simulation = create();
+
+    try
+    {
+        for (const auto& busElement : element.at("buses"))
+        {
+            uint8_t bus = parseByte(busElement.at("bus"));
+            if (busElement.contains("byte_time_us"))
+            {
+                simulation->setByteTime(
+                    bus, std::chrono::microseconds{parseNumber(
+                             busElement["byte_time_us"], UINT32_MAX)});
+            }
+
+            if (busElement.contains("devices"))
+            {
+                for (const auto& deviceElement : busElement["devices"])
+                {
+                    uint8_t addr = parseByte(deviceElement.at("address"));
+                    simulation->addDevice(bus, addr,
+                                          parseDevice(deviceElement));
+                }
+            }
+        }
+    }
+    catch (const json::exception& e)
+    {
+        throw std::invalid_argument{e.what()};
+    }
+
+    return simulation;
+}
+
+std::shared_ptr<SimulatedI2C>
+    SimulatedI2C::load(const std::filesystem::path& path)
+{
+    std::ifstream file{path};
+    if (!file)
+    {
+        throw std::runtime_error{"Unable to open " + path.string()};
+    }
+    return create(json::parse(file));
+}
+
+void SimulatedI2C::addDevice(uint8_t bus, uint8_t addr, Device device)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    state.devices.insert_or_assign(addr, std::move(device));
+}
+
+void SimulatedI2C::setByteTime(uint8_t bus, std::chrono::microseconds byteTime)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    state.byteTime = byteTime;
+}
+
+std::unique_ptr<I2CInterface>
+    SimulatedI2C::createInterface(uint8_t bus, uint8_t addr,
+                                  I2CInterface::InitialState initialState,
+                                  int maxRetries)
+{
+    // Add the bus now so transactions don't change the bus map
+    getBus(bus);
+
+    auto interface = std::make_unique<SimulatedI2CInterface>(
+        shared_from_this(), bus, addr, maxRetries);
+    if (initialState == I2CInterface::InitialState::OPEN)
+    {
+        interface->open();
+    }
+    return interface;
+}
+
+int SimulatedI2C::transact(uint8_t bus, uint8_t addr,
+                           std::optional<uint8_t> command, size_t bytes,
+                           const Action& action)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+
+    // The address byte goes on the bus whether or not a device answers
+    auto device = state.devices.find(addr);
+    if ((device == state.devices.end()) || device->second.nack)
+    {
+        std::this_thread::sleep_for(state.byteTime);
+        state.busyTime += state.byteTime;
+        if (device != state.devices.end())
+        {
+            device->second.transactions++;
+            device->second.errors++;
+        }
+        return ENXIO;
+    }
+
+    auto& dev = device->second;
+    auto time = dev.latency + state.byteTime * (1 + bytes);
+    std::this_thread::sleep_for(time);
+    state.busyTime += time;
+    dev.transactions++;
+
+    for (auto& fault : dev.faults)
+    {
+        if (fault.command && (fault.command != command))
+        {
+            continue;
+        }
+
+        fault.matched++;
+        if (((fault.matched % fault.every) == 0) &&
+            ((fault.count == 0) || (fault.injected < fault.count)))
+        {
+            fault.injected++;
+            dev.errors++;
+            return fault.error;
+        }
+    }
+
+    int error = action(dev);
+    if (error != 0)
+    {
+        dev.errors++;
+    }
+    return error;
+}
+
+void SimulatedI2C::setRegister(uint8_t bus, uint8_t addr, uint8_t command,
+                               std::vector<uint8_t> value)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    state.devices[addr].registers[command] = std::move(value);
+}
+
+std::optional<std::vector<uint8_t>>
+    SimulatedI2C::getRegister(uint8_t bus, uint8_t addr, uint8_t command)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+
+    auto device = state.devices.find(addr);
+    if (device == state.devices.end())
+    {
+        return std::nullopt;
+    }
+    auto value = device->second.registers.find(command);
+    if (value == device->second.registers.end())
+    {
+        return std::nullopt;
+    }
+    return value->second;
+}
+
+size_t SimulatedI2C::getTransactions(uint8_t bus, uint8_t addr)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    auto device = state.devices.find(addr);
+    return (device != state.devices.end()) ? device->second.transactions : 0;
+}
+
+size_t SimulatedI2C::getErrors(uint8_t bus, uint8_t addr)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    auto device = state.devices.find(addr);
+    return (device != state.devices.end()) ? device->second.errors : 0;
+}
+
+std::chrono::microseconds SimulatedI2C::getBusyTime(uint8_t bus)
+{
+    auto& state = getBus(bus);
+    std::lock_guard lock{state.mutex};
+    return state.busyTime;
+}
+
+SimulatedI2C::Bus& SimulatedI2C::getBus(uint8_t bus)
+{
+    std::lock_guard lock{mutex};
+    return buses[bus];
+}
+
+} // namespace i2c
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "../i2c_interface.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace i2c
+{
+
+/** @brief Simulated I2C buses with register-map devices, like PMBus devices
+ *
+ * The simulation gives I2CInterface objects that behave like I2CDevice
+ * objects talking to real devices, without hardware.  It models:
+ * - the registers of each device, by command code
+ * - the time each transaction takes, from a per-device latency plus a
+ *   per-byte time on the bus
+ * - bus contention, since one transaction runs on a bus at a time
+ * - NACKs and errors injected on some transactions
+ *
+ * The buses can be described in JSON:
+ *
+ * @code
+ * {
+ *   "buses": [
+ *     {
+ *       "bus": 3,
+ *       "byte_time_us": 90,
+ *       "devices": [
+ *         {
+ *           "address": "0x70",
+ *           "latency_us": 50,
+ *           "registers": { "0x20": [ "0x17" ], "0x8B": [ "0x00", "0x0C" ] },
+ *           "faults": [ { "command": "0x8B", "every": 10, "errno": 5 } ]
+ *         },
+ *         { "address": "0x71", "nack": true }
+ *       ]
+ *     }
+ *   ]
+ * }
+ * @endcode
+ *
+ * Numbers can be JSON numbers or hex strings.  Register values are listed
+ * low byte first, the order they are sent on the bus.  A fault fails every
+ * Nth transaction with the command, or with any command if "command" is
+ * left out, up to "count" times if given.  Reading a register that isn't
+ * in the map, or any transaction with a "nack" device, fails with ENXIO
+ * like a device that doesn't acknowledge.  A fault with errno 74, EBADMSG,
+ * looks like a PEC failure.
+ */
+class SimulatedI2C : public std::enable_shared_from_this<SimulatedI2C>
+{
+  public:
+    SimulatedI2C(const SimulatedI2C&) = delete;
+    SimulatedI2C& operator=(const SimulatedI2C&) = delete;
+
+    /** @brief An injected error */
+    struct Fault
+    {
+        /** @brief The command code it applies to; any if not set */
+        std::optional<uint8_t> command;
+
+        /** @brief Fail every Nth matching transaction */
+        unsigned int every = 1;
+
+        /** @brief The most transactions to fail; 0 for no limit */
+        unsigned int count = 0;
+
+        /** @brief The errno value of the failures */
+        int error = EIO;
+
+        /** @brief The number of matching transactions so far */
+        unsigned int matched = 0;
+
+        /** @brief The number of failures so far */
+        unsigned int injected = 0;
+    };
+
+    /** @brief A simulated device */
+    struct Device
+    {
+        /** @brief The register values by command code, low byte first */
+        std::map<uint8_t, std::vector<uint8_t>> registers;
+
+        /** @brief The time the device takes per transaction */
+        std::chrono::microseconds latency{0};
+
+        /** @brief Whether the device doesn't acknowledge its address */
+        bool nack = false;
+
+        /** @brief The injected errors */
+        std::vector<Fault> faults;
+
+        /** @brief The command code set by the last send byte */
+        uint8_t pointer = 0;
+
+        /** @brief The number of transactions done */
+        size_t transactions = 0;
+
+        /** @brief The number of transactions that failed */
+        size_t errors = 0;
+    };
+
+    /** @brief Does the data part of a transaction on a device
+     *
+     * Returns 0, or the errno value to fail the transaction with.
+     */
+    using Action = std::function<int(Device&)>;
+
+    /** @brief Create a simulation with no buses
+     *
+     * @return The simulation
+     */
+    static std::shared_ptr<SimulatedI2C> create();
+
+    /** @brief Create a simulation from a JSON description
+     *
+     * @param[in] element - The JSON description
+     *
+     * @throw std::invalid_argument if the description isn't valid
+     * @return The simulation
+     */
+    static std::shared_ptr<SimulatedI2C> create(const nlohmann::json& element);
+
+    /** @brief Create a simulation from a JSON file
+     *
+     * @param[in] path - The JSON file
+     *
+     * @throw std::exception if the file can't be read or isn't valid
+     * @return The simulation
+     */
+    static std::shared_ptr<SimulatedI2C>
+        load(const std::filesystem::path& path);
+
+    /** @brief Add a device, replacing any at the same address
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     * @param[in] device - The device
+     */
+    void addDevice(uint8_t bus, uint8_t addr, Device device);
+
+    /** @brief Set the time each byte takes on a bus
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] byteTime - The time per byte
+     */
+    void setByteTime(uint8_t bus, std::chrono::microseconds byteTime);
+
+    /** @brief Create an interface to a device
+     *
+     * The device doesn't have to exist; if it doesn't, its transactions
+     * fail with ENXIO.
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     * @param[in] initialState - Initial state of the interface
+     * @param[in] maxRetries - Maximum number of times to retry an operation
+     *
+     * @return The interface
+     */
+    std::unique_ptr<I2CInterface> createInterface(
+        uint8_t bus, uint8_t addr,
+        I2CInterface::InitialState initialState =
+            I2CInterface::InitialState::OPEN,
+        int maxRetries = 0);
+
+    /** @brief Do one transaction on a device, holding the bus for the time
+     *         it takes
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     * @param[in] command - The command code, if the transaction has one
+     * @param[in] bytes - The number of data bytes sent on the bus
+     * @param[in] action - Does the data part of the transaction
+     *
+     * @return 0, or the errno value the transaction failed with
+     */
+    int transact(uint8_t bus, uint8_t addr, std::optional<uint8_t> command,
+                 size_t bytes, const Action& action);
+
+    /** @brief Set the value of a register
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     * @param[in] command - The command code
+     * @param[in] value - The value, low byte first
+     */
+    void setRegister(uint8_t bus, uint8_t addr, uint8_t command,
+                     std::vector<uint8_t> value);
+
+    /** @brief Get the value of a register
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     * @param[in] command - The command code
+     *
+     * @return The value, low byte first, or nothing if not in the map
+     */
+    std::optional<std::vector<uint8_t>>
+        getRegister(uint8_t bus, uint8_t addr, uint8_t command);
+
+    /** @brief Get the number of transactions done with a device
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     *
+     * @return The transaction count, including failed ones
+     */
+    size_t getTransactions(uint8_t bus, uint8_t addr);
+
+    /** @brief Get the number of transactions with a device that failed
+     *
+     * @param[in] bus - The i2c bus ID
+     * @param[in] addr - The device address
+     *
+     * @return The error count
+     */
+    size_t getErrors(uint8_t bus, uint8_t addr);
+
+    /** @brief Get the total time transactions have used a bus
+     *
+     * @param[in] bus - The i2c bus ID
+     *
+     * @return The busy time
+     */
+    std::chrono::microseconds getBusyTime(uint8_t bus);
+
+  private:
+    SimulatedI2C() = default;
+
+    struct Bus
+    {
+        /** @brief Held for the duration of each transaction */
+        std::mutex mutex;
+
+        std::chrono::microseconds byteTime{0};
+        std::chrono::microseconds busyTime{0};
+        std::map<uint8_t, Device> devices;
+    };
+
+    /** @brief Get a bus, adding it if needed
+     *
+     * @param[in] bus - The i2c bus ID
+     *
+     * @return The bus, which stays valid as long as this object
+     */
+    Bus& getBus(uint8_t bus);
+
+    /** @brief Protects the bus map; the buses have their own mutexes */
+    std::mutex mutex;
+
+    std::map<uint8_t, Bus> buses;
+};
+
+} // namespace i2c
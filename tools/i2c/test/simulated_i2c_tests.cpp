@@ -0,0 +1,285 @@
+#include "simulated_i2c.hpp"
+
+#include <linux/i2c.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace i2c;
+using namespace std::chrono_literals;
+
+using json = nlohmann::json;
+
+namespace
+{
+
+const json description = R"(
+{
+  "buses": [
+    {
+      "bus": 3,
+      "devices": [
+        {
+          "address": "0x70",
+          "registers": {
+            "0x20": [ "0x17" ],
+            "0x8B": [ "0x00", "0x0C" ],
+            "0x9A": [ 65, 66, 67 ]
+          }
+        },
+        { "address": 113, "nack": true }
+      ]
+    }
+  ]
+}
+)"_json;
+
+} // namespace
+
+TEST(SimulatedI2CTests, Read)
+{
+    auto simulation = SimulatedI2C::create(description);
+    auto device = simulation->createInterface(3, 0x70);
+
+    uint8_t byte = 0;
+    device->read(0x20, byte);
+    EXPECT_EQ(byte, 0x17);
+
+    uint16_t word = 0;
+    device->read(0x8B, word);
+    EXPECT_EQ(word, 0x0C00);
+
+    std::array<uint8_t, I2C_SMBUS_BLOCK_MAX> block{};
+    uint8_t size = 0;
+    device->read(0x9A, size, block.data());
+    EXPECT_EQ(size, 3);
+    EXPECT_EQ(block[2], 'C');
+
+    // The receive byte reads the register selected by a send byte
+    device->write(uint8_t{0x20});
+    device->read(byte);
+    EXPECT_EQ(byte, 0x17);
+
+    uint8_t command = 0x8B;
+    std::array<uint8_t, 2> value{};
+    std::array<I2CInterface::Message, 2> messages{
+        I2CInterface::Message::write(&command, 1),
+        I2CInterface::Message::read(value.data(), value.size())};
+    device->transfer(messages);
+    EXPECT_EQ(value, (std::array<uint8_t, 2>{0x00, 0x0C}));
+
+    EXPECT_EQ(simulation->getTransactions(3, 0x70), 6);
+    EXPECT_EQ(simulation->getErrors(3, 0x70), 0);
+}
+
+TEST(SimulatedI2CTests, ReadRange)
+{
+    auto simulation = SimulatedI2C::create();
+    simulation->addDevice(3, 0x72, {});
+    for (uint8_t reg = 0x10; reg < 0x70; reg += I2C_SMBUS_BLOCK_MAX)
+    {
+        simulation->setRegister(3, 0x72, reg,
+                                std::vector<uint8_t>(I2C_SMBUS_BLOCK_MAX, reg));
+    }
+    auto device = simulation->createInterface(3, 0x72);
+
+    // Read in 32 byte blocks at the registers after each block
+    std::vector<uint8_t> data(70);
+    device->readRange(0x10, data);
+    EXPECT_EQ(data[0], 0x10);
+    EXPECT_EQ(data[31], 0x10);
+    EXPECT_EQ(data[32], 0x30);
+    EXPECT_EQ(data[64], 0x50);
+    EXPECT_EQ(data[69], 0x50);
+    EXPECT_EQ(simulation->getTransactions(3, 0x72), 3);
+
+    // The range can't go past the last register
+    try
+    {
+        device->readRange(0xF0, data);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_EQ(e.errorCode, EINVAL);
+    }
+    EXPECT_EQ(simulation->getTransactions(3, 0x72), 3);
+}
+
+TEST(SimulatedI2CTests, Write)
+{
+    auto simulation = SimulatedI2C::create(description);
+    auto device = simulation->createInterface(3, 0x70);
+
+    device->write(0x21, uint16_t{0x1234});
+    EXPECT_EQ(simulation->getRegister(3, 0x70, 0x21),
+              (std::vector<uint8_t>{0x34, 0x12}));
+
+    uint16_t word = 0;
+    device->read(0x21, word);
+    EXPECT_EQ(word, 0x1234);
+
+    simulation->setRegister(3, 0x70, 0x21, {0x01, 0x02});
+    device->read(0x21, word);
+    EXPECT_EQ(word, 0x0201);
+}
+
+TEST(SimulatedI2CTests, Errors)
+{
+    auto simulation = SimulatedI2C::create(description);
+
+    // Operations need an open device
+    auto device = simulation->createInterface(
+        3, 0x70, I2CInterface::InitialState::CLOSED);
+    uint8_t byte = 0;
+    EXPECT_THROW(device->read(0x20, byte), I2CException);
+    device->open();
+    EXPECT_THROW(device->open(), I2CException);
+
+    // A register not in the map isn't acknowledged
+    try
+    {
+        device->read(0x55, byte);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_EQ(e.errorCode, ENXIO);
+        EXPECT_STREQ(e.what(), "I2CException: Failed to read byte data: bus "
+                               "/dev/i2c-3, addr 0x70, errno 6: No such "
+                               "device or address");
+    }
+
+    // Neither is a missing device, or one set to NACK
+    auto missing = simulation->createInterface(3, 0x72);
+    EXPECT_THROW(missing->read(0x20, byte), I2CException);
+    auto nack = simulation->createInterface(3, 0x71);
+    EXPECT_THROW(nack->read(0x20, byte), I2CException);
+    EXPECT_EQ(simulation->getErrors(3, 0x71), 1);
+}
+
+TEST(SimulatedI2CTests, Faults)
+{
+    json faulty = description;
+    faulty["buses"][0]["devices"][0]["faults"] =
+        R"([ { "command": "0x8B", "every": 3, "count": 2, "errno": 5 } ])"_json;
+    auto simulation = SimulatedI2C::create(faulty);
+
+    // Every third word read fails, twice
+    auto device = simulation->createInterface(3, 0x70);
+    uint16_t word = 0;
+    int failures = 0;
+    for (int i = 0; i < 9; i++)
+    {
+        try
+        {
+            device->read(0x8B, word);
+        }
+        catch (const I2CException& e)
+        {
+            EXPECT_EQ(e.errorCode, EIO);
+            failures++;
+        }
+    }
+    EXPECT_EQ(failures, 2);
+
+    // Other commands aren't affected
+    uint8_t byte = 0;
+    device->read(0x20, byte);
+    device->read(0x20, byte);
+    device->read(0x20, byte);
+
+    // With a retry the failures aren't seen
+    auto faults = faulty;
+    faults["buses"][0]["devices"][0]["faults"][0]["count"] = 0;
+    simulation = SimulatedI2C::create(faults);
+    device = simulation->createInterface(
+        3, 0x70, I2CInterface::InitialState::OPEN, 1);
+    for (int i = 0; i < 9; i++)
+    {
+        device->read(0x8B, word);
+    }
+    EXPECT_EQ(simulation->getTransactions(3, 0x70), 13);
+    EXPECT_EQ(simulation->getErrors(3, 0x70), 4);
+}
+
+TEST(SimulatedI2CTests, PEC)
+{
+    json faulty = description;
+    faulty["buses"][0]["devices"][0]["faults"] =
+        R"([ { "command": "0x8B", "errno": 74 } ])"_json;
+    auto simulation = SimulatedI2C::create(faulty);
+    simulation->setByteTime(3, 10us);
+
+    auto device = simulation->createInterface(3, 0x70);
+    device->setPEC(true);
+
+    try
+    {
+        uint16_t word = 0;
+        device->read(0x8B, word);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_TRUE(e.isPECError());
+    }
+
+    // The PEC byte takes bus time
+    uint8_t byte = 0;
+    device->read(0x20, byte);
+    EXPECT_EQ(simulation->getBusyTime(3), 5 * 10us + 4 * 10us);
+}
+
+TEST(SimulatedI2CTests, Contention)
+{
+    auto simulation = SimulatedI2C::create();
+    SimulatedI2C::Device device;
+    device.registers[0x8B] = {0x00, 0x0C};
+    device.latency = 2ms;
+    simulation->addDevice(1, 0x40, device);
+    simulation->addDevice(1, 0x41, device);
+    simulation->setByteTime(1, 10us);
+
+    // Transactions with different devices on one bus take turns
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint8_t addr : {0x40, 0x41})
+    {
+        threads.emplace_back([&simulation, addr] {
+            auto interface = simulation->createInterface(1, addr);
+            uint16_t word = 0;
+            for (int i = 0; i < 5; i++)
+            {
+                interface->read(0x8B, word);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Each transaction is 2ms plus 4 bytes of 10us
+    EXPECT_EQ(simulation->getBusyTime(1), 10 * 2040us);
+    EXPECT_GE(elapsed, 10 * 2040us);
+}
+
+TEST(SimulatedI2CTests, InvalidDescription)
+{
+    EXPECT_THROW(SimulatedI2C::create(json::object()), std::invalid_argument);
+    EXPECT_THROW(
+        SimulatedI2C::create(R"({"buses": [{"bus": "0x1FF"}]})"_json),
+        std::invalid_argument);
+    EXPECT_THROW(
+        SimulatedI2C::create(
+            R"({"buses": [{"bus": 1, "devices": [{"address": "x"}]}]})"_json),
+        std::invalid_argument);
+}
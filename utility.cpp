@@ -15,8 +15,11 @@
  */
 #include "utility.hpp"
 
+#include "service_cache.hpp"
 #include "types.hpp"
 
+#include <sdbusplus/exception.hpp>
+
 #include <fstream>
 
 namespace phosphor
@@ -36,6 +39,16 @@ using json = nlohmann::json;
 std::string getService(const std::string& path, const std::string& interface,
                        sdbusplus::bus::bus& bus, bool logError)
 {
+    auto& cache = ServiceCache::get();
+    if (cache.isEnabled())
+    {
+        auto service = cache.find(path, interface);
+        if (service)
+        {
+            return *service;
+        }
+    }
+
     auto method = bus.new_method_call(MAPPER_BUSNAME, MAPPER_PATH,
                                       MAPPER_INTERFACE, "GetObject");
 
@@ -60,6 +73,11 @@ std::string getService(const std::string& path, const std::string& interface,
         return std::string{};
     }
 
+    if (cache.isEnabled())
+    {
+        cache.add(path, interface, response.begin()->first);
+    }
+
     return response.begin()->first;
 }
 
@@ -88,6 +106,43 @@ DbusPropertyMap getAllProperties(sdbusplus::bus::bus& bus,
     return properties;
 }
 
+void callAsync(sdbusplus::bus::bus& bus, sdbusplus::message::message& method,
+               AsyncCallback callback)
+{
+    auto* data = new AsyncCallback{std::move(callback)};
+
+    auto handler = [](sd_bus_message* m, void* userdata, sd_bus_error*) {
+        sdbusplus::message::message reply{m};
+        try
+        {
+            (*static_cast<AsyncCallback*>(userdata))(reply);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>("Error handling D-Bus method reply",
+                            entry("ERROR=%s", e.what()));
+        }
+        return 0;
+    };
+
+    sd_bus_slot* slot = nullptr;
+    int r = sd_bus_call_async(bus.get(), &slot, method.get(), handler, data,
+                              0);
+    if (r < 0)
+    {
+        delete data;
+        throw sdbusplus::exception::SdBusError(-r, "sd_bus_call_async");
+    }
+
+    // The bus owns the call from here on, and deletes the callback when the
+    // reply has been handled
+    sd_bus_slot_set_destroy_callback(slot, [](void* userdata) {
+        delete static_cast<AsyncCallback*>(userdata);
+    });
+    sd_bus_slot_set_floating(slot, 1);
+    sd_bus_slot_unref(slot);
+}
+
 DbusSubtree getSubTree(sdbusplus::bus::bus& bus, const std::string& path,
                        const std::string& interface, int32_t depth)
 {
@@ -7,6 +7,7 @@
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus.hpp>
 
+#include <functional>
 #include <string>
 
 namespace phosphor
@@ -36,6 +37,8 @@ using DbusPropertyMap = std::map<DbusProperty, DbusVariant>;
  * @brief Get the service name from the mapper for the
  *        interface and path passed in.
  *
+ * Uses the ServiceCache once the program has enabled it.
+ *
  * @param[in] path - the D-Bus path name
  * @param[in] interface - the D-Bus interface name
  * @param[in] bus - the D-Bus object
@@ -114,6 +117,28 @@ DbusPropertyMap getAllProperties(sdbusplus::bus::bus& bus,
                                  const std::string& interface,
                                  const std::string& service = std::string());
 
+/**
+ * @brief The function called with the reply to an asynchronous method call.
+ *
+ * The reply is an error message if the call failed; check it with
+ * is_method_error().
+ */
+using AsyncCallback = std::function<void(sdbusplus::message::message& reply)>;
+
+/**
+ * @brief Call a D-Bus method without waiting for the reply
+ *
+ * The callback is called from the event loop the bus is attached to when
+ * the reply comes in, or when the call times out.  Exceptions it throws are
+ * logged and dropped.
+ *
+ * @param[in] bus - the D-Bus object
+ * @param[in] method - the method call message
+ * @param[in] callback - the function to call with the reply
+ */
+void callAsync(sdbusplus::bus::bus& bus, sdbusplus::message::message& method,
+               AsyncCallback callback);
+
 /** @brief Get subtree from the object mapper.
  *
  * Helper function to find objects, services, and interfaces.